@@ -0,0 +1,130 @@
+#!/bin/bash
+
+## Smoke check of the server over a temporary local socket:
+## a valid request, invalid requests and the shutdown
+
+DIRNAME=$(dirname "$0")
+
+function usage {
+    printf "USAGE: %s [<xspace_cmd>]\n" "$0"
+
+    [[ -n $1 ]] && exit $1
+}
+
+[[ $1 =~ ^(-h|--help)$ ]] && usage 0
+
+CMD="${1:-$DIRNAME/../../build/xspace}"
+[[ -x $CMD ]] || {
+    printf "Not an executable: %s\n" "$CMD" >&2
+    usage 1 >&2
+}
+
+command -v python3 >/dev/null || {
+    printf "python3 is required to act as the client\n" >&2
+    exit 1
+}
+
+MODEL="$DIRNAME/../models/heart_attack/heart_attack-50.nnet"
+STRATEGIES='abductive'
+# 13 features of the first sample of heart_attack_full.csv
+SAMPLE='[63, 1, 3, 145, 233, 1, 0, 150, 0, 2.3, 0, 0, 1]'
+
+TMP_DIR=$(mktemp -d) || exit $?
+SOCKET="$TMP_DIR/xspace.sock"
+SERVER_PID=
+
+function cleanup {
+    [[ -n $SERVER_PID ]] && kill $SERVER_PID 2>/dev/null
+    rm -rf "$TMP_DIR"
+}
+trap cleanup EXIT
+
+## A file that is not a socket must not be replaced
+REGULAR_FILE="$TMP_DIR/results.csv"
+printf "keep\n" >"$REGULAR_FILE"
+"$CMD" serve "$MODEL" "$STRATEGIES" --socket "$REGULAR_FILE" 2>/dev/null && {
+    printf "The server accepted an existing regular file as the socket\n" >&2
+    exit 3
+}
+[[ $(cat "$REGULAR_FILE") == keep ]] || {
+    printf "The server replaced an existing regular file\n" >&2
+    exit 3
+}
+printf "OK: existing regular file kept\n"
+
+"$CMD" serve "$MODEL" "$STRATEGIES" --socket "$SOCKET" &
+SERVER_PID=$!
+
+for i in {1..100}; do
+    [[ -S $SOCKET ]] && break
+    kill -0 $SERVER_PID 2>/dev/null || {
+        printf "The server terminated before it created the socket\n" >&2
+        exit 2
+    }
+    sleep 0.1
+done
+[[ -S $SOCKET ]] || {
+    printf "The server did not create the socket: %s\n" "$SOCKET" >&2
+    exit 2
+}
+
+python3 - "$SOCKET" "$SAMPLE" <<'EOF' || exit $?
+import json
+import socket
+import sys
+
+socket_path, sample = sys.argv[1], json.loads(sys.argv[2])
+
+with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+    sock.connect(socket_path)
+    reader = sock.makefile('r')
+
+    def request(line):
+        sock.sendall((line + '\n').encode())
+        response = reader.readline()
+        if not response:
+            sys.exit('The server closed the connection after: ' + line)
+        return json.loads(response)
+
+    def check(cond, what, response):
+        if not cond:
+            sys.exit('FAILED: ' + what + ': ' + json.dumps(response))
+        print('OK: ' + what)
+
+    response = request(json.dumps({'sample': sample}))
+    explanations = response.get('explanations')
+    check(explanations is not None and len(explanations) == 1, 'valid request', response)
+    check('explanation' in explanations[0] and 'features' in explanations[0], 'explanation fields', response)
+
+    response = request(json.dumps({'sample': sample[:-1]}))
+    check('error' in response, 'sample of a wrong size', response)
+
+    response = request('{"samples": ')
+    check('error' in response, 'invalid JSON', response)
+
+    # The formula explanations refer to the terms of the verifier
+    response = request(json.dumps({'sample': sample, 'strategies': 'itp'}))
+    explanations = response.get('explanations')
+    check(explanations is not None and len(explanations) == 1, 'interpolation request', response)
+
+    response = request(json.dumps({'sample': sample, 'strategies': 'nonexistent'}))
+    check('error' in response, 'invalid strategies', response)
+
+    response = request(json.dumps({'shutdown': True}))
+    check(response == {'shutdown': True}, 'shutdown', response)
+EOF
+
+wait $SERVER_PID
+STATUS=$?
+SERVER_PID=
+[[ $STATUS == 0 ]] || {
+    printf "The server exited with status %d\n" $STATUS >&2
+    exit 3
+}
+[[ -e $SOCKET ]] && {
+    printf "The server did not remove the socket\n" >&2
+    exit 3
+}
+
+printf "OK: the server shut down\n"
+exit 0
@@ -0,0 +1,100 @@
+#include "IntervalBoundPropagation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace xai::nn {
+
+namespace {
+// Float products are exact in double, the sums are off by at most (n * eps) times the sum of the magnitudes
+constexpr double relativeError = 1e-12;
+
+struct LinearBounds {
+    double lower;
+    double upper;
+};
+
+template<typename WeightFn>
+LinearBounds computeLinearBounds(std::size_t size, WeightFn weightOf, double bias, std::vector<double> const & lower,
+                                 std::vector<double> const & upper) {
+    double lo = bias;
+    double hi = bias;
+    double magnitude = std::abs(bias);
+    for (std::size_t i = 0; i < size; ++i) {
+        double const w = weightOf(i);
+        double const wLo = w * lower[i];
+        double const wHi = w * upper[i];
+        lo += std::min(wLo, wHi);
+        hi += std::max(wLo, wHi);
+        magnitude += std::max(std::abs(wLo), std::abs(wHi));
+    }
+
+    double const margin = magnitude * relativeError;
+    return {.lower = lo - margin, .upper = hi + margin};
+}
+} // namespace
+
+void IntervalBoundPropagation::propagate(Bounds const & inputLower, Bounds const & inputUpper) {
+    assert(inputLower.size() == network.getInputSize());
+    assert(inputUpper.size() == network.getInputSize());
+
+    lower.assign(inputLower.begin(), inputLower.end());
+    upper.assign(inputUpper.begin(), inputUpper.end());
+
+    std::size_t const numLayers = network.getNumLayers();
+    for (std::size_t layer = 1; layer < numLayers - 1; ++layer) {
+        std::size_t const layerSize = network.getLayerSize(layer);
+        nextLower.resize(layerSize);
+        nextUpper.resize(layerSize);
+        for (std::size_t node = 0; node < layerSize; ++node) {
+            auto const & weights = network.getWeights(layer, node);
+            assert(weights.size() == lower.size());
+            auto const [lo, hi] = computeLinearBounds(
+                weights.size(), [&weights](std::size_t i) { return weights[i]; }, network.getBias(layer, node), lower,
+                upper);
+            // ReLU
+            nextLower[node] = std::max(lo, 0.);
+            nextUpper[node] = std::max(hi, 0.);
+        }
+        lower.swap(nextLower);
+        upper.swap(nextUpper);
+    }
+}
+
+double IntervalBoundPropagation::getOutputLowerBound(std::size_t node) const {
+    std::size_t const lastLayer = network.getNumLayers() - 1;
+    auto const & weights = network.getWeights(lastLayer, node);
+    assert(weights.size() == lower.size());
+    return computeLinearBounds(
+               weights.size(), [&weights](std::size_t i) { return weights[i]; }, network.getBias(lastLayer, node),
+               lower, upper)
+        .lower;
+}
+
+double IntervalBoundPropagation::getOutputUpperBound(std::size_t node) const {
+    std::size_t const lastLayer = network.getNumLayers() - 1;
+    auto const & weights = network.getWeights(lastLayer, node);
+    assert(weights.size() == lower.size());
+    return computeLinearBounds(
+               weights.size(), [&weights](std::size_t i) { return weights[i]; }, network.getBias(lastLayer, node),
+               lower, upper)
+        .upper;
+}
+
+double IntervalBoundPropagation::getOutputDifferenceUpperBound(std::size_t node, std::size_t refNode) const {
+    std::size_t const lastLayer = network.getNumLayers() - 1;
+    auto const & weights = network.getWeights(lastLayer, node);
+    auto const & refWeights = network.getWeights(lastLayer, refNode);
+    assert(weights.size() == lower.size());
+    assert(refWeights.size() == lower.size());
+    // The difference of two floats is exact in double
+    double const bias = double(network.getBias(lastLayer, node)) - network.getBias(lastLayer, refNode);
+    return computeLinearBounds(
+               weights.size(),
+               [&weights, &refWeights](std::size_t i) { return double(weights[i]) - double(refWeights[i]); }, bias,
+               lower, upper)
+        .upper;
+}
+
+} // namespace xai::nn
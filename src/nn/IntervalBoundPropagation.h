@@ -0,0 +1,38 @@
+#ifndef XAI_SMT_INTERVALBOUNDPROPAGATION_H
+#define XAI_SMT_INTERVALBOUNDPROPAGATION_H
+
+#include "NNet.h"
+
+#include <vector>
+
+namespace xai::nn {
+// Sound over-approximation of the values of the network over a box of inputs (IBP)
+// The bounds are widened by a margin that covers the rounding errors of the computation
+class IntervalBoundPropagation {
+public:
+    using Bounds = std::vector<float>;
+
+    IntervalBoundPropagation(NNet const & nn) : network{nn} {}
+
+    // Propagates the input box up to the last hidden layer
+    void propagate(Bounds const & inputLower, Bounds const & inputUpper);
+
+    double getOutputLowerBound(std::size_t node) const;
+    double getOutputUpperBound(std::size_t node) const;
+
+    // Computed symbolically w.r.t. the last hidden layer, which is tighter than the difference of the output bounds
+    double getOutputDifferenceUpperBound(std::size_t node, std::size_t refNode) const;
+
+private:
+    NNet const & network;
+
+    // Bounds of the last hidden layer (after ReLU)
+    std::vector<double> lower{};
+    std::vector<double> upper{};
+
+    std::vector<double> nextLower{};
+    std::vector<double> nextUpper{};
+};
+} // namespace xai::nn
+
+#endif // XAI_SMT_INTERVALBOUNDPROPAGATION_H
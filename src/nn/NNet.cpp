@@ -1,13 +1,26 @@
 #include "NNet.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#if defined(__AVX512F__) or defined(__AVX2__)
+#include <immintrin.h>
+#endif
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <numeric>
 #include <ranges>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace stdr = std::ranges;
 
@@ -25,13 +38,51 @@ std::vector<std::string> split(std::string const & s, char delimiter) {
 }
 template<typename TTransform>
 auto parseValues(std::string const & s, TTransform transformation, char delimiter = ',') {
-    auto valueRange = split(s,delimiter) | stdr::views::transform([&](auto const & s) { return transformation(s); });
+    auto valueRange = split(s,delimiter) | stdr::views::transform([&](auto const & v) { return transformation(v); });
     using valType = std::invoke_result_t<TTransform, std::string>;
     std::vector<valType> values;
     std::ranges::copy(valueRange, std::back_inserter(values));
     return values;
 }
 
+constexpr char binaryMagic[8] = {'X', 'S', 'P', 'N', 'N', 'E', 'T', '\0'};
+constexpr std::uint32_t binaryVersion = 1;
+// Detects a different byte order
+constexpr std::uint32_t binaryByteOrderMark = 0x01020304;
+
+// Followed by the sizes of the layers as std::uint64_t, then by the minimum and the maximum values of the inputs,
+// then by the parameters at an offset that is a multiple of the alignment
+struct BinaryHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::uint64_t numLayers;
+    std::uint64_t parametersSize;
+};
+
+std::size_t binaryParametersOffset(std::size_t numLayers, std::size_t numInputs) {
+    std::size_t const size =
+        sizeof(BinaryHeader) + numLayers * sizeof(std::uint64_t) + 2 * numInputs * sizeof(float);
+    return (size + NNet::alignment - 1) / NNet::alignment * NNet::alignment;
+}
+} // namespace
+
+std::unique_ptr<NNet> NNet::fromFile(std::string_view filename) {
+    std::ifstream file{std::string{filename}, std::ios::binary};
+    if (not file.good()) {
+        throw std::ifstream::failure{"Could not open model file " + std::string{filename}};
+    }
+
+    char magic[sizeof(binaryMagic)]{};
+    file.read(magic, sizeof(magic));
+    bool const isBinary = (file.gcount() == sizeof(magic) and std::ranges::equal(magic, binaryMagic));
+    file.close();
+
+    if (isBinary) {
+        return fromBinaryFile(filename);
+    } else {
+        return fromTextFile(filename);
+    }
 }
 
 /// Load neural network from .nnet file.
@@ -47,7 +98,7 @@ auto parseValues(std::string const & s, TTransform transformation, char delimite
 /// 7: Mean values of inputs and one value for all outputs (used for normalization)
 /// 8: Range values of inputs and one value for all outputs (used for normalization)
 /// 9+: Begin defining the weight matrix for the first layer, followed by the bias vector. The weights and biases for the second layer follow after, until the weights and biases for the output layer are defined.
-std::unique_ptr<NNet> NNet::fromFile(std::string_view filename) {
+std::unique_ptr<NNet> NNet::fromTextFile(std::string_view filename) {
     std::ifstream file{std::string{filename}};
     if (not file.good()) {
         throw std::ifstream::failure{"Could not open model file " + std::string{filename}};
@@ -90,18 +141,33 @@ std::unique_ptr<NNet> NNet::fromFile(std::string_view filename) {
         std::getline(file, line);
     }
 
+    auto network = std::unique_ptr<NNet>(new NNet());
+    std::vector<std::size_t> layerSizes(layer_sizes.begin(), layer_sizes.end());
+    std::size_t const parametersSize = network->initLayers(layerSizes);
+    // Zero padding
+    auto parametersPtr = std::make_shared<AlignedFloats>(parametersSize, 0);
+    float * const parametersData = parametersPtr->data();
+
     // Parse model parameters
-    weights_t weights(numLayers);
-    std::vector<std::vector<float>> biases(numLayers);
     for (int layer = 0; layer < numLayers - 1; layer++) {
-        // Parse weights
+        auto const [weightsOffset, biasesOffset] = network->layerOffsets[layer];
         auto layerSize = layer_sizes.at(layer + 1);
+        auto prevLayerSize = layer_sizes.at(layer);
+        std::size_t const stride = makeStride(prevLayerSize);
+
+        // Parse weights
         for (int i = 0; i < layerSize; i++) {
             std::getline(file, line);
             std::vector<std::string> weightStrings = split(line, ',');
-            weights[layer].emplace_back();
-            for (const auto& weightString : weightStrings) {
-                weights[layer][i].push_back(std::stof(weightString));
+            // Otherwise the row would be written out of the bounds of the weight matrix
+            if (weightStrings.size() != prevLayerSize) {
+                throw std::invalid_argument{"Expected " + std::to_string(prevLayerSize) + " weights of node " +
+                                            std::to_string(i + 1) + " of layer " + std::to_string(layer + 1) +
+                                            ", got: " + std::to_string(weightStrings.size())};
+            }
+            float * const row = parametersData + weightsOffset + i * stride;
+            for (std::size_t j = 0; j < prevLayerSize; ++j) {
+                row[j] = std::stof(weightStrings[j]);
             }
         }
 
@@ -109,23 +175,242 @@ std::unique_ptr<NNet> NNet::fromFile(std::string_view filename) {
         for (int i = 0; i < layerSize; i++) {
             std::getline(file, line);
             std::vector<std::string> biasStrings = split(line, ',');
+            if (biasStrings.empty()) {
+                throw std::invalid_argument{"Missing bias of node " + std::to_string(i + 1) + " of layer " +
+                                            std::to_string(layer + 1)};
+            }
             std::string biasString = biasStrings[0];
-            biases[layer].push_back(std::stof(biasString));
+            parametersData[biasesOffset + i] = std::stof(biasString);
         }
     }
     file.close();
-    auto network = std::unique_ptr<NNet>(new NNet());
     network->numInputs = numInputs;
     network->numOutputs = numOutputs;
-    network->numLayers = numLayers;
     network->maxLayerSize = maxLayerSize;
     network->inputMinimums = std::move(inputMinValues);
     network->inputMaximums = std::move(inputMaxValues);
-    network->weights = std::move(weights);
-    network->biases = std::move(biases);
+    network->setParameters(std::shared_ptr<float const>(parametersPtr, parametersData));
     return network;
 }
 
+std::unique_ptr<NNet> NNet::fromParameters(std::vector<std::size_t> const & layerSizes,
+                                           std::vector<std::vector<float>> const & weights,
+                                           std::vector<std::vector<float>> const & biases,
+                                           std::vector<float> inputMinValues, std::vector<float> inputMaxValues) {
+    std::size_t const numLayers = layerSizes.size();
+    if (numLayers < 2) { throw std::invalid_argument{"Missing layers of the model"}; }
+    if (std::ranges::find(layerSizes, 0) != layerSizes.end()) {
+        throw std::invalid_argument{"Empty layer of the model"};
+    }
+    if (weights.size() != numLayers - 1 or biases.size() != numLayers - 1) {
+        throw std::invalid_argument{"Expected the weights and the biases of " + std::to_string(numLayers - 1) +
+                                    " layers of the model"};
+    }
+    std::size_t const numInputs = layerSizes.front();
+    if (inputMinValues.size() != numInputs or inputMaxValues.size() != numInputs) {
+        throw std::invalid_argument{"Expected the bounds of " + std::to_string(numInputs) + " inputs of the model"};
+    }
+
+    auto network = std::unique_ptr<NNet>(new NNet());
+    std::size_t const parametersSize = network->initLayers(layerSizes);
+    // Zero padding
+    auto parametersPtr = std::make_shared<AlignedFloats>(parametersSize, 0);
+    float * const parametersData = parametersPtr->data();
+
+    for (std::size_t layer = 0; layer < numLayers - 1; ++layer) {
+        auto const [weightsOffset, biasesOffset] = network->layerOffsets[layer];
+        std::size_t const layerSize = layerSizes[layer + 1];
+        std::size_t const prevLayerSize = layerSizes[layer];
+        std::size_t const stride = makeStride(prevLayerSize);
+        auto const & layerWeights = weights[layer];
+        auto const & layerBiases = biases[layer];
+        if (layerWeights.size() != layerSize * prevLayerSize or layerBiases.size() != layerSize) {
+            throw std::invalid_argument{"Inconsistent size of the parameters of layer " + std::to_string(layer + 1) +
+                                        " of the model"};
+        }
+
+        for (std::size_t i = 0; i < layerSize; ++i) {
+            std::ranges::copy_n(layerWeights.begin() + i * prevLayerSize, prevLayerSize,
+                                parametersData + weightsOffset + i * stride);
+        }
+        std::ranges::copy(layerBiases, parametersData + biasesOffset);
+    }
+
+    network->numInputs = numInputs;
+    network->numOutputs = layerSizes.back();
+    network->maxLayerSize = *std::ranges::max_element(layerSizes | std::views::drop(1));
+    network->inputMinimums = std::move(inputMinValues);
+    network->inputMaximums = std::move(inputMaxValues);
+    network->setParameters(std::shared_ptr<float const>(parametersPtr, parametersData));
+    return network;
+}
+
+std::unique_ptr<NNet> NNet::fromBinaryFile(std::string_view filename) {
+    std::string const filenameStr{filename};
+    auto const failure = [&](std::string const & msg) {
+        return std::ifstream::failure{msg + " in model file " + filenameStr};
+    };
+
+    int const fd = ::open(filenameStr.c_str(), O_RDONLY);
+    if (fd < 0) { throw std::ifstream::failure{"Could not open model file " + filenameStr}; }
+    struct ::stat fileStat{};
+    if (::fstat(fd, &fileStat) != 0) {
+        ::close(fd);
+        throw std::ifstream::failure{"Could not open model file " + filenameStr};
+    }
+    std::size_t const fileSize = fileStat.st_size;
+    void * const addr = (fileSize > 0) ? ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    // The mapping stays valid after closing the file
+    ::close(fd);
+    if (addr == MAP_FAILED) { throw failure("Could not map the contents"); }
+    std::shared_ptr<void const> mapping{addr, [fileSize](void const * p) { ::munmap(const_cast<void *>(p), fileSize); }};
+
+    auto const * const bytes = static_cast<char const *>(addr);
+    if (fileSize < sizeof(BinaryHeader)) { throw failure("Truncated header"); }
+    BinaryHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (not std::ranges::equal(header.magic, binaryMagic)) { throw failure("Missing magic"); }
+    if (header.version != binaryVersion) { throw failure("Unsupported version " + std::to_string(header.version)); }
+    if (header.byteOrderMark != binaryByteOrderMark) { throw failure("Different byte order"); }
+    if (header.numLayers < 2) { throw failure("Missing layers"); }
+    // All the sizes are bounded by the size of the file first, so that none of the computations below overflows
+    if (header.numLayers > (fileSize - sizeof(BinaryHeader)) / sizeof(std::uint64_t)) {
+        throw failure("Truncated header");
+    }
+
+    std::size_t const numLayers = header.numLayers;
+    std::size_t const maxFloats = fileSize / sizeof(float);
+    std::vector<std::size_t> layerSizes(numLayers);
+    for (std::size_t layer = 0; layer < numLayers; ++layer) {
+        std::uint64_t layerSize;
+        std::memcpy(&layerSize, bytes + sizeof(BinaryHeader) + layer * sizeof(std::uint64_t), sizeof(layerSize));
+        if (layerSize == 0) { throw failure("Empty layer " + std::to_string(layer)); }
+        if (layerSize > maxFloats) { throw failure("Invalid size of layer " + std::to_string(layer)); }
+        layerSizes[layer] = layerSize;
+    }
+
+    std::size_t const numInputs = layerSizes.front();
+    std::size_t const parametersOffset = binaryParametersOffset(numLayers, numInputs);
+    if (fileSize < parametersOffset) { throw failure("Truncated input bounds"); }
+
+    // The same layout as computed by initLayers, but checked against the remaining size of the file
+    constexpr std::size_t alignedSize = alignment / sizeof(float);
+    std::size_t const maxParametersSize = (fileSize - parametersOffset) / sizeof(float);
+    std::size_t expectedParametersSize = 0;
+    for (std::size_t layer = 0; layer < numLayers - 1; ++layer) {
+        std::size_t const layerSize = layerSizes[layer + 1];
+        std::size_t const stride = makeStride(layerSizes[layer]);
+        std::size_t const biasesSize = (layerSize + alignedSize - 1) / alignedSize * alignedSize;
+        std::size_t const remainingSize = maxParametersSize - expectedParametersSize;
+        if (layerSize > remainingSize / stride or biasesSize > remainingSize - layerSize * stride) {
+            throw failure("Truncated parameters");
+        }
+        expectedParametersSize += layerSize * stride + biasesSize;
+    }
+
+    auto network = std::unique_ptr<NNet>(new NNet());
+    std::size_t const parametersSize = network->initLayers(layerSizes);
+    assert(parametersSize == expectedParametersSize);
+    if (parametersSize != header.parametersSize) { throw failure("Inconsistent size of the parameters"); }
+    assert(fileSize >= parametersOffset + parametersSize * sizeof(float));
+
+    char const * const inputBounds = bytes + sizeof(BinaryHeader) + numLayers * sizeof(std::uint64_t);
+    std::vector<float> inputMinValues(numInputs);
+    std::vector<float> inputMaxValues(numInputs);
+    std::memcpy(inputMinValues.data(), inputBounds, numInputs * sizeof(float));
+    std::memcpy(inputMaxValues.data(), inputBounds + numInputs * sizeof(float), numInputs * sizeof(float));
+
+    auto const * const parametersData = reinterpret_cast<float const *>(bytes + parametersOffset);
+    assert(reinterpret_cast<std::uintptr_t>(parametersData) % alignment == 0);
+
+    network->numInputs = numInputs;
+    network->numOutputs = layerSizes.back();
+    network->maxLayerSize = *std::ranges::max_element(layerSizes | std::views::drop(1));
+    network->inputMinimums = std::move(inputMinValues);
+    network->inputMaximums = std::move(inputMaxValues);
+    network->setParameters(std::shared_ptr<float const>(std::move(mapping), parametersData));
+    return network;
+}
+
+void NNet::writeBinaryFile(std::string_view filename) const {
+    std::ofstream file{std::string{filename}, std::ios::binary};
+    if (not file.good()) {
+        throw std::ofstream::failure{"Could not open model file " + std::string{filename}};
+    }
+
+    BinaryHeader header{};
+    std::ranges::copy(binaryMagic, header.magic);
+    header.version = binaryVersion;
+    header.byteOrderMark = binaryByteOrderMark;
+    header.numLayers = numLayers;
+    header.parametersSize = parametersSize;
+    file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+
+    for (std::size_t layer = 0; layer < numLayers; ++layer) {
+        std::uint64_t const layerSize = getLayerSize(layer);
+        file.write(reinterpret_cast<char const *>(&layerSize), sizeof(layerSize));
+    }
+
+    file.write(reinterpret_cast<char const *>(inputMinimums.data()), numInputs * sizeof(float));
+    file.write(reinterpret_cast<char const *>(inputMaximums.data()), numInputs * sizeof(float));
+
+    std::size_t const parametersOffset = binaryParametersOffset(numLayers, numInputs);
+    std::size_t const paddingSize = parametersOffset - std::size_t(file.tellp());
+    assert(paddingSize < alignment);
+    char const padding[alignment]{};
+    file.write(padding, paddingSize);
+
+    file.write(reinterpret_cast<char const *>(parameters.get()), parametersSize * sizeof(float));
+    if (not file.good()) {
+        throw std::ofstream::failure{"Could not write model file " + std::string{filename}};
+    }
+}
+
+std::size_t NNet::initLayers(std::vector<std::size_t> const & layerSizes) {
+    assert(layerSizes.size() >= 2);
+    numLayers = layerSizes.size();
+    layers.resize(numLayers - 1);
+    layerOffsets.resize(numLayers - 1);
+
+    constexpr std::size_t alignedSize = alignment / sizeof(float);
+    std::size_t offset = 0;
+    for (std::size_t layer = 0; layer < numLayers - 1; ++layer) {
+        auto & layerData = layers[layer];
+        layerData.size = layerSizes[layer + 1];
+        layerData.prevSize = layerSizes[layer];
+        layerData.stride = makeStride(layerData.prevSize);
+
+        auto & [weightsOffset, biasesOffset] = layerOffsets[layer];
+        weightsOffset = offset;
+        offset += layerData.size * layerData.stride;
+        biasesOffset = offset;
+        offset += (layerData.size + alignedSize - 1) / alignedSize * alignedSize;
+    }
+
+    parametersSize = offset;
+    return parametersSize;
+}
+
+void NNet::setParameters(std::shared_ptr<float const> params) {
+    parameters = std::move(params);
+    for (std::size_t layer = 0; layer < numLayers - 1; ++layer) {
+        auto const [weightsOffset, biasesOffset] = layerOffsets[layer];
+        layers[layer].weights = parameters.get() + weightsOffset;
+        layers[layer].biases = parameters.get() + biasesOffset;
+    }
+}
+
+std::size_t NNet::makeStride(std::size_t prevSize) {
+    constexpr std::size_t alignedSize = alignment / sizeof(float);
+    return (prevSize + alignedSize - 1) / alignedSize * alignedSize;
+}
+
+NNet::Layer const & NNet::getLayer(std::size_t layerNum) const {
+    assert(layerNum > 0);
+    assert(layerNum <= layers.size());
+    return layers[layerNum - 1];
+}
+
 std::size_t NNet::getInputSize() const {
     return numInputs;
 }
@@ -133,20 +418,32 @@ std::size_t NNet::getInputSize() const {
 std::size_t NNet::getLayerSize(std::size_t layerNum) const {
     if (layerNum == 0)
         return numInputs;
-    assert(layerNum <= biases.size());
-    return biases[layerNum - 1].size();
+    return getLayer(layerNum).size;
 }
 
-std::vector<float> const & NNet::getWeights(std::size_t layerNum, std::size_t nodeIndex) const {
-    assert(layerNum > 0);
-    assert(nodeIndex < getLayerSize(layerNum));
-    return weights[layerNum - 1][nodeIndex];
+std::span<float const> NNet::getWeights(std::size_t layerNum, std::size_t nodeIndex) const {
+    auto const & layer = getLayer(layerNum);
+    assert(nodeIndex < layer.size);
+    return {layer.weights + nodeIndex * layer.stride, layer.prevSize};
+}
+
+float const * NNet::getWeightsData(std::size_t layerNum) const {
+    return getLayer(layerNum).weights;
+}
+
+std::size_t NNet::getWeightsStride(std::size_t layerNum) const {
+    return getLayer(layerNum).stride;
 }
 
 float NNet::getBias(std::size_t layerNum, std::size_t nodeIndex) const {
-    assert(layerNum > 0);
-    assert(nodeIndex < getLayerSize(layerNum));
-    return biases[layerNum - 1][nodeIndex];
+    auto const & layer = getLayer(layerNum);
+    assert(nodeIndex < layer.size);
+    return layer.biases[nodeIndex];
+}
+
+std::span<float const> NNet::getBiases(std::size_t layerNum) const {
+    auto const & layer = getLayer(layerNum);
+    return {layer.biases, layer.size};
 }
 
 float NNet::getInputLowerBound(std::size_t nodeIndex) const {
@@ -159,31 +456,225 @@ float NNet::getInputUpperBound(std::size_t nodeIndex) const {
     return inputMaximums.at(nodeIndex);
 }
 
+namespace {
+// Calls `f(j)` for j = 0 .. n-1 such that the loop is always unrolled and the per-j state can be kept in registers
+template<std::size_t n, typename F>
+inline void unrolledFor(F && f) {
+    [&]<std::size_t... j>(std::index_sequence<j...>) { (f(j), ...); }(std::make_index_sequence<n>{});
+}
+
+// Dot products of a row of weights with `n` arrays of values that are `valuesStride` floats apart
+// All arrays are aligned and padded with zeros up to the size, which is a multiple of the alignment
+// Each of the dot products is accumulated in the same order regardless of `n`,
+// hence the results do not depend on how the inputs are batched
+// The scalar version accumulates in the same order as a sequential sum starting from `init`
+template<std::size_t n>
+std::array<float, n> dotProducts(float init, float const * weights, float const * values, std::size_t valuesStride,
+                                 [[maybe_unused]] std::size_t size, [[maybe_unused]] std::size_t paddedSize) {
+    std::array<float, n> results;
+#if defined(__AVX512F__)
+    __m512 acc[n];
+    std::fill_n(acc, n, _mm512_setzero_ps());
+    for (std::size_t i = 0; i < paddedSize; i += 16) {
+        __m512 const w = _mm512_load_ps(weights + i);
+        unrolledFor<n>([&](std::size_t j) {
+            acc[j] = _mm512_fmadd_ps(w, _mm512_load_ps(values + j * valuesStride + i), acc[j]);
+        });
+    }
+    unrolledFor<n>([&](std::size_t j) { results[j] = init + _mm512_reduce_add_ps(acc[j]); });
+#elif defined(__AVX2__) and defined(__FMA__)
+    __m256 acc0[n];
+    __m256 acc1[n];
+    std::fill_n(acc0, n, _mm256_setzero_ps());
+    std::fill_n(acc1, n, _mm256_setzero_ps());
+    for (std::size_t i = 0; i < paddedSize; i += 16) {
+        __m256 const w0 = _mm256_load_ps(weights + i);
+        __m256 const w1 = _mm256_load_ps(weights + i + 8);
+        unrolledFor<n>([&](std::size_t j) {
+            float const * const vals = values + j * valuesStride + i;
+            acc0[j] = _mm256_fmadd_ps(w0, _mm256_load_ps(vals), acc0[j]);
+            acc1[j] = _mm256_fmadd_ps(w1, _mm256_load_ps(vals + 8), acc1[j]);
+        });
+    }
+    unrolledFor<n>([&](std::size_t j) {
+        __m256 const acc = _mm256_add_ps(acc0[j], acc1[j]);
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+        results[j] = init + _mm_cvtss_f32(sum);
+    });
+#else
+    results.fill(init);
+    for (std::size_t i = 0; i < size; ++i) {
+        float const w = weights[i];
+        unrolledFor<n>([&](std::size_t j) { results[j] += w * values[j * valuesStride + i]; });
+    }
+#endif
+    return results;
+}
+
+// No. inputs that share the loads of the weights
+constexpr std::size_t inputsBlockSize = 4;
+// No. rows of the weights that are applied to a block of inputs before moving on to the next block,
+// such that the rows stay in the cache
+constexpr std::size_t nodesBlockSize = 32;
+// No. inputs that are propagated through all the layers together
+constexpr std::size_t batchTileSize = 64;
+
+template<std::size_t n>
+void computeNodes(NNet const & network, std::size_t layerNum, std::size_t beginNode, std::size_t endNode,
+                  float const * inputs, std::size_t inputsStride, float * outputs, std::size_t outputsStride,
+                  bool relu) {
+    std::size_t const prevLayerSize = network.getLayerSize(layerNum - 1);
+    std::size_t const stride = network.getWeightsStride(layerNum);
+    float const * const weights = network.getWeightsData(layerNum);
+    auto const biases = network.getBiases(layerNum);
+    for (std::size_t node = beginNode; node < endNode; ++node) {
+        auto const vals =
+            dotProducts<n>(biases[node], weights + node * stride, inputs, inputsStride, prevLayerSize, stride);
+        for (std::size_t j = 0; j < n; ++j) {
+            float const val = vals[j];
+            outputs[j * outputsStride + node] = (relu and val < 0) ? 0 : val;
+        }
+    }
+}
+
+std::size_t makeBatchStride(NNet const & network) {
+    std::size_t const numLayers = network.getNumLayers();
+    std::size_t maxSize = network.getInputSize();
+    for (std::size_t layer = 1; layer < numLayers; ++layer) {
+        maxSize = std::max({maxSize, network.getWeightsStride(layer), network.getLayerSize(layer)});
+    }
+
+    constexpr std::size_t alignedSize = NNet::alignment / sizeof(float);
+    return (maxSize + alignedSize - 1) / alignedSize * alignedSize;
+}
+
+// Propagates a tile of inputs through all the layers, using two buffers of `batchSize` rows of `batchStride` floats
+// The inputs are in the first buffer and the outputs end up in the returned one
+float const * computeTile(NNet const & network, float * buffer, float * otherBuffer, std::size_t batchSize,
+                          std::size_t batchStride) {
+    std::size_t const numLayers = network.getNumLayers();
+    for (std::size_t layer = 1; layer < numLayers; ++layer) {
+        bool const isOutputLayer = (layer == numLayers - 1);
+        computeLayer(network, layer, buffer, batchStride, otherBuffer, batchStride, batchSize, not isOutputLayer);
+        std::swap(buffer, otherBuffer);
+        if (isOutputLayer) { break; }
+
+        std::size_t const layerSize = network.getLayerSize(layer);
+        std::size_t const nextStride = network.getWeightsStride(layer + 1);
+        for (std::size_t i = 0; i < batchSize; ++i) {
+            float * const row = buffer + i * batchStride;
+            std::fill(row + layerSize, row + nextStride, 0.f);
+        }
+    }
+
+    return buffer;
+}
+} // namespace
+
+void computeLayer(NNet const & network, std::size_t layerNum, float const * input, float * output, bool relu) {
+    std::size_t const layerSize = network.getLayerSize(layerNum);
+    computeNodes<1>(network, layerNum, 0, layerSize, input, 0, output, 0, relu);
+}
+
+void computeLayer(NNet const & network, std::size_t layerNum, float const * inputs, std::size_t inputsStride,
+                  float * outputs, std::size_t outputsStride, std::size_t batchSize, bool relu) {
+    std::size_t const layerSize = network.getLayerSize(layerNum);
+    for (std::size_t beginNode = 0; beginNode < layerSize; beginNode += nodesBlockSize) {
+        std::size_t const endNode = std::min(beginNode + nodesBlockSize, layerSize);
+        std::size_t i = 0;
+        for (; i + inputsBlockSize <= batchSize; i += inputsBlockSize) {
+            computeNodes<inputsBlockSize>(network, layerNum, beginNode, endNode, inputs + i * inputsStride,
+                                          inputsStride, outputs + i * outputsStride, outputsStride, relu);
+        }
+        for (; i < batchSize; ++i) {
+            computeNodes<1>(network, layerNum, beginNode, endNode, inputs + i * inputsStride, 0,
+                            outputs + i * outputsStride, 0, relu);
+        }
+    }
+}
+
 NNet::output_t computeOutput(NNet::input_t const & inputValues, NNet const & network) {
     auto inputSize = network.getInputSize();
     if (inputValues.size() != inputSize) { throw std::logic_error("Input values do not have expected size!"); }
 
-    auto previousLayerValues = inputValues;
-    std::vector<float> currentLayerValues;
-    for (auto layer = 1u; layer < network.getNumLayers(); ++layer) {
-        for (auto node = 0u; node < network.getLayerSize(layer); ++node) {
-            auto const & incomingWeights = network.getWeights(layer, node);
-            assert(incomingWeights.size() == previousLayerValues.size());
-            std::vector<float> addends;
-            for (std::size_t i = 0; i < incomingWeights.size(); ++i) {
-                addends.push_back(incomingWeights[i] * previousLayerValues[i]);
+    std::size_t const numLayers = network.getNumLayers();
+    std::size_t bufferSize = 0;
+    for (std::size_t layer = 1; layer < numLayers; ++layer) {
+        bufferSize = std::max({bufferSize, network.getWeightsStride(layer), network.getLayerSize(layer)});
+    }
+
+    // The buffers of consecutive layers are swapped, the padding must stay zero
+    NNet::AlignedFloats previousLayerValues(bufferSize);
+    NNet::AlignedFloats currentLayerValues(bufferSize);
+    std::ranges::copy(inputValues, previousLayerValues.begin());
+
+    for (std::size_t layer = 1; layer < numLayers; ++layer) {
+        bool const isOutputLayer = (layer == numLayers - 1);
+        computeLayer(network, layer, previousLayerValues.data(), currentLayerValues.data(), not isOutputLayer);
+        if (isOutputLayer) { break; }
+
+        std::size_t const layerSize = network.getLayerSize(layer);
+        std::size_t const nextStride = network.getWeightsStride(layer + 1);
+        std::fill(currentLayerValues.begin() + layerSize, currentLayerValues.begin() + nextStride, 0.f);
+        previousLayerValues.swap(currentLayerValues);
+    }
+
+    std::size_t const outputSize = network.getLayerSize(numLayers - 1);
+    return NNet::output_t(currentLayerValues.begin(), currentLayerValues.begin() + outputSize);
+}
+
+NNet::output_t computeOutputs(std::span<float const> inputs, std::size_t batchSize, NNet const & network,
+                              std::size_t nThreads) {
+    std::size_t const inputSize = network.getInputSize();
+    if (inputs.size() != batchSize * inputSize) { throw std::logic_error("Input values do not have expected size!"); }
+
+    std::size_t const outputSize = network.getLayerSize(network.getNumLayers() - 1);
+    NNet::output_t outputs(batchSize * outputSize);
+    if (batchSize == 0) { return outputs; }
+
+    std::size_t const batchStride = makeBatchStride(network);
+    std::size_t const nTiles = (batchSize + batchTileSize - 1) / batchTileSize;
+    nThreads = std::clamp<std::size_t>(nThreads, 1, nTiles);
+
+    // Each thread processes every `nThreads`-th tile, the tiles write to disjoint parts of the outputs
+    auto work = [&](std::size_t threadIdx) {
+        NNet::AlignedFloats buffer(batchTileSize * batchStride);
+        NNet::AlignedFloats otherBuffer(batchTileSize * batchStride);
+        for (std::size_t tile = threadIdx; tile < nTiles; tile += nThreads) {
+            std::size_t const begin = tile * batchTileSize;
+            std::size_t const tileSize = std::min(batchTileSize, batchSize - begin);
+
+            std::ranges::fill(buffer, 0.f);
+            for (std::size_t i = 0; i < tileSize; ++i) {
+                auto const input = inputs.subspan((begin + i) * inputSize, inputSize);
+                std::ranges::copy(input, buffer.begin() + i * batchStride);
+            }
+
+            float const * const tileOutputs = computeTile(network, buffer.data(), otherBuffer.data(), tileSize,
+                                                          batchStride);
+            for (std::size_t i = 0; i < tileSize; ++i) {
+                float const * const output = tileOutputs + i * batchStride;
+                std::copy(output, output + outputSize, outputs.begin() + (begin + i) * outputSize);
             }
-            currentLayerValues.push_back(std::accumulate(addends.begin(), addends.end(), network.getBias(layer, node)));
         }
-        if (layer < network.getNumLayers() - 1) {
-            std::transform(currentLayerValues.begin(), currentLayerValues.end(), currentLayerValues.begin(), [](float val) {
-               return val >= 0.0f ? val : 0.0f;
-            });
-            previousLayerValues = std::move(currentLayerValues);
-            currentLayerValues.clear();
+    };
+
+    if (nThreads == 1) {
+        work(0);
+        return outputs;
+    }
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(nThreads);
+        for (std::size_t threadIdx = 0; threadIdx < nThreads; ++threadIdx) {
+            threads.emplace_back(work, threadIdx);
         }
     }
-    return currentLayerValues;
+
+    return outputs;
 }
 
 } // namespace xai::nn
@@ -1,8 +1,12 @@
 #ifndef XAI_SMT_NNET_H
 #define XAI_SMT_NNET_H
 
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace xai::nn {
@@ -11,25 +15,88 @@ public:
     using input_t = std::vector<float>;
     using output_t = std::vector<float>;
 
+    // Alignment of the rows of the weight matrices, suitable for the widest vector instructions
+    static constexpr std::size_t alignment = 64;
+
+    template<typename T>
+    struct AlignedAllocator {
+        using value_type = T;
+
+        template<typename U>
+        struct rebind {
+            using other = AlignedAllocator<U>;
+        };
+
+        AlignedAllocator() = default;
+        template<typename U>
+        AlignedAllocator(AlignedAllocator<U> const &) noexcept {}
+
+        T * allocate(std::size_t n) {
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+        }
+        void deallocate(T * p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{alignment}); }
+
+        friend bool operator==(AlignedAllocator const &, AlignedAllocator const &) { return true; }
+    };
+
+    using AlignedFloats = std::vector<float, AlignedAllocator<float>>;
+
+    // Detects whether the file is in the text .nnet format or in the binary format
     static std::unique_ptr<NNet> fromFile(std::string_view filename);
 
+    // Constructs the network from the parameters held in memory, including the input layer in the layer sizes
+    // The weights of each further layer form a row-major matrix with one row per node, without any padding
+    static std::unique_ptr<NNet> fromParameters(std::vector<std::size_t> const & layerSizes,
+                                                std::vector<std::vector<float>> const & weights,
+                                                std::vector<std::vector<float>> const & biases,
+                                                std::vector<float> inputMinValues, std::vector<float> inputMaxValues);
+
+    // The binary format is loaded by mapping the file to memory without copying the parameters
+    // It consists of a header with the layer sizes and the input bounds,
+    // followed by the aligned weight matrices and biases of the layers, in the same layout as in memory
+    void writeBinaryFile(std::string_view filename) const;
+
     std::size_t getNumLayers() const { return numLayers; }
 
     std::size_t getLayerSize(std::size_t layerNum) const;
     std::size_t getInputSize() const;
 
-    std::vector<float> const & getWeights(std::size_t layerNum, std::size_t nodeIndex) const;
+    std::span<float const> getWeights(std::size_t layerNum, std::size_t nodeIndex) const;
+
+    // Row-major matrix with one row per node, the rows are aligned and padded with zeros up to the stride
+    float const * getWeightsData(std::size_t layerNum) const;
+    std::size_t getWeightsStride(std::size_t layerNum) const;
 
     float getBias(std::size_t layerNum, std::size_t nodeIndex) const;
+    std::span<float const> getBiases(std::size_t layerNum) const;
 
     float getInputLowerBound(std::size_t node) const;
     float getInputUpperBound(std::size_t node) const;
 
 private:
+    struct Layer {
+        std::size_t size;
+        std::size_t prevSize;
+        std::size_t stride;
+        // Point to `parameters`
+        float const * weights;
+        float const * biases;
+    };
+
+    static std::unique_ptr<NNet> fromTextFile(std::string_view filename);
+    static std::unique_ptr<NNet> fromBinaryFile(std::string_view filename);
+
+    // Multiple of the alignment
+    static std::size_t makeStride(std::size_t prevSize);
+
     NNet() = default;
 
-    using weights_t = std::vector<std::vector<std::vector<float>>>;
-    using biases_t = std::vector<std::vector<float>>;
+    // Lays out the parameters of the layers of the given sizes one after another
+    // Returns the total no. floats, each layer starts at an aligned offset
+    std::size_t initLayers(std::vector<std::size_t> const & layerSizes);
+    void setParameters(std::shared_ptr<float const> params);
+
+    Layer const & getLayer(std::size_t layerNum) const;
 
     std::size_t numLayers;
     std::size_t numInputs;
@@ -37,12 +104,30 @@ private:
     std::size_t maxLayerSize;
     std::vector<float> inputMinimums;
     std::vector<float> inputMaximums;
-    weights_t weights;
-    biases_t biases;
+    // Does not include the input layer
+    std::vector<Layer> layers;
+    // The offsets of the weights and of the biases of each layer in `parameters`
+    std::vector<std::pair<std::size_t, std::size_t>> layerOffsets;
+    std::size_t parametersSize;
+    // Either allocated or mapped from a binary file
+    std::shared_ptr<float const> parameters;
 };
 
+// Computes the values of the nodes of the layer from the values of the previous layer
+// The input must be aligned and padded with zeros up to the stride of the weights of the layer
+void computeLayer(NNet const &, std::size_t layerNum, float const * input, float * output, bool relu);
+// The same for a batch of inputs, which are stored in rows that are `inputsStride` floats apart, and similarly the outputs
+// The rows of the inputs must be aligned and padded as above
+void computeLayer(NNet const &, std::size_t layerNum, float const * inputs, std::size_t inputsStride, float * outputs,
+                  std::size_t outputsStride, std::size_t batchSize, bool relu);
+
 NNet::output_t computeOutput(NNet::input_t const &, NNet const &);
 
+// Computes the outputs of a batch of inputs that are stored contiguously one after another
+// The outputs are stored the same way, they are equal to the outputs of `computeOutput` of the individual inputs
+NNet::output_t computeOutputs(std::span<float const> inputs, std::size_t batchSize, NNet const &,
+                              std::size_t nThreads = 1);
+
 }
 
 
@@ -3,6 +3,8 @@
 
 #include <nn/NNet.h>
 
+#include <chrono>
+#include <stop_token>
 #include <string>
 #include <vector>
 
@@ -15,6 +17,45 @@ class Verifier {
 public:
     enum class Answer { SAT, UNSAT, UNKNOWN, ERROR };
 
+    // Assumptions are terms that are only considered within `checkAssuming`
+    // They remain valid until `resetSampleQuery` and must not be used after the level they were added at is popped
+    using Assumption = std::size_t;
+    using Assumptions = std::vector<Assumption>;
+
+    // Limits of each of the following checks, where zero means unlimited
+    // A check that exceeds its budget answers UNKNOWN
+    // Not all verifiers support all the limits
+    struct Budget {
+        // In seconds
+        double timeout{};
+        std::size_t conflicts{};
+        // The check is abandoned once a stop is requested, e.g. when its result is no longer needed
+        std::stop_token stopToken{};
+    };
+
+    // Receives the calls of the verifier together with their durations, e.g. to trace them
+    class Tracer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class Call { loadModel, push, pop, check };
+
+        struct CallInfo {
+            Call call;
+            Clock::time_point start;
+            Clock::time_point end{};
+            // The following are only relevant for checks
+            Answer answer{Answer::UNKNOWN};
+            // Number of the bounds asserted at the time of the check
+            std::size_t terms{};
+            std::size_t assumptions{};
+        };
+
+        virtual ~Tracer() = default;
+
+        virtual void traceCall(CallInfo const &) = 0;
+    };
+
     Verifier() = default;
     virtual ~Verifier() = default;
     Verifier(Verifier const &) = delete;
@@ -22,16 +63,42 @@ public:
     Verifier(Verifier &&) = default;
     Verifier & operator=(Verifier &&) = default;
 
-    virtual void loadModel(nn::NNet const &) = 0;
+    void loadModel(nn::NNet const & network) {
+        auto const start = traceStart();
+        loadModelImpl(network);
+        trace({.call = Tracer::Call::loadModel, .start = start});
+    }
 
-    virtual void addUpperBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) = 0;
-    virtual void addLowerBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) = 0;
-    virtual void addEquality(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) {
-        addInterval(layer, var, value, value, explanationTerm);
+    // Each of the following counts as a single asserted term
+    void addUpperBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) {
+        addUpperBoundImpl(layer, var, value, explanationTerm);
+        ++termsCount;
+    }
+    void addLowerBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) {
+        addLowerBoundImpl(layer, var, value, explanationTerm);
+        ++termsCount;
+    }
+    void addEquality(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) {
+        addEqualityImpl(layer, var, value, explanationTerm);
+        ++termsCount;
     }
-    virtual void addInterval(LayerIndex layer, NodeIndex var, float lo, float hi, bool explanationTerm = false) {
-        addUpperBound(layer, var, hi, explanationTerm);
-        addLowerBound(layer, var, lo, explanationTerm);
+    void addInterval(LayerIndex layer, NodeIndex var, float lo, float hi, bool explanationTerm = false) {
+        addIntervalImpl(layer, var, lo, hi, explanationTerm);
+        ++termsCount;
+    }
+
+    Assumption addUpperBoundAssumption(LayerIndex layer, NodeIndex var, float value) {
+        return addAssumption({.kind = AssumptionTerm::Kind::upper, .layer = layer, .var = var, .hi = value});
+    }
+    Assumption addLowerBoundAssumption(LayerIndex layer, NodeIndex var, float value) {
+        return addAssumption({.kind = AssumptionTerm::Kind::lower, .layer = layer, .var = var, .lo = value});
+    }
+    Assumption addEqualityAssumption(LayerIndex layer, NodeIndex var, float value) {
+        return addAssumption(
+            {.kind = AssumptionTerm::Kind::equality, .layer = layer, .var = var, .lo = value, .hi = value});
+    }
+    Assumption addIntervalAssumption(LayerIndex layer, NodeIndex var, float lo, float hi) {
+        return addAssumption({.kind = AssumptionTerm::Kind::interval, .layer = layer, .var = var, .lo = lo, .hi = hi});
     }
 
     virtual void addClassificationConstraint(NodeIndex node, float threshold) = 0;
@@ -43,33 +110,180 @@ public:
         reset();
     }
 
-    virtual void push() { pushImpl(); }
-    virtual void pop() { popImpl(); }
+    virtual void push() {
+        auto const start = traceStart();
+        pushImpl();
+        termsCountStack.push_back(termsCount);
+        trace({.call = Tracer::Call::push, .start = start});
+    }
+    virtual void pop() {
+        auto const start = traceStart();
+        popImpl();
+        if (not termsCountStack.empty()) {
+            termsCount = termsCountStack.back();
+            termsCountStack.pop_back();
+        }
+        trace({.call = Tracer::Call::pop, .start = start});
+    }
 
     virtual Answer check() {
         ++checksCount;
-        return checkImpl();
+        inputModel.clear();
+        checkInterrupted = false;
+        auto const start = traceStart();
+        Answer const answer = checkImpl();
+        trace({.call = Tracer::Call::check, .start = start, .answer = answer, .terms = termsCount});
+        return answer;
+    }
+
+    // Checks the current assertions together with the given assumptions
+    Answer checkAssuming(Assumptions const & assumptions) {
+        ++checksCount;
+        inputModel.clear();
+        checkInterrupted = false;
+        auto const start = traceStart();
+        Answer const answer = checkAssumingImpl(assumptions);
+        trace({.call = Tracer::Call::check,
+               .start = start,
+               .answer = answer,
+               .terms = termsCount,
+               .assumptions = assumptions.size()});
+        return answer;
     }
 
     std::size_t getChecksCount() const { return checksCount; }
 
-    virtual void resetSampleQuery() {}
+    virtual void setCheckBudget(Budget const & budget) { checkBudget = budget; }
+    Budget const & getCheckBudget() const { return checkBudget; }
+
+    // Whether the last check answered UNKNOWN because it exceeded its budget or a stop was requested,
+    // as opposed to the verifier giving up on its own (e.g. if it is incomplete)
+    bool lastCheckInterrupted() const { return checkInterrupted; }
+
+    // Only counted by the verifiers that support the conflict limits
+    std::size_t getConflictsCount() const { return conflictsCount; }
+
+    // If enabled, the values of the input variables are extracted from the model of each check that answers SAT
+    // Not all verifiers support it
+    virtual void produceInputModels(bool produce = true) { _produceInputModels = produce; }
+    bool producingInputModels() const { return _produceInputModels; }
+
+    // Values of the input variables in the model of the last check
+    // Empty if the last check did not answer SAT or if the model is not available
+    std::vector<float> const & getInputModel() const { return inputModel; }
+
+    virtual void resetSampleQuery() { assumptionTerms.clear(); }
     virtual void resetSample() {
         resetSampleQuery();
         checksCount = 0;
+        conflictsCount = 0;
     }
-    virtual void reset() { resetSample(); }
+    virtual void reset() {
+        resetSample();
+        termsCount = 0;
+        termsCountStack.clear();
+    }
+
+    // The tracer must outlive the verifier or be unset
+    void setTracer(Tracer * tracer) { tracerPtr = tracer; }
 
 protected:
+    struct AssumptionTerm {
+        enum class Kind { upper, lower, equality, interval };
+
+        Kind kind;
+        LayerIndex layer;
+        NodeIndex var;
+        float lo{};
+        float hi{};
+    };
+
     virtual void initImpl() {}
 
+    virtual void loadModelImpl(nn::NNet const &) = 0;
+
+    virtual void addUpperBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) = 0;
+    virtual void addLowerBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) = 0;
+    virtual void addEqualityImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) {
+        addIntervalImpl(layer, var, value, value, explanationTerm);
+    }
+    virtual void addIntervalImpl(LayerIndex layer, NodeIndex var, float lo, float hi, bool explanationTerm) {
+        addUpperBoundImpl(layer, var, hi, explanationTerm);
+        addLowerBoundImpl(layer, var, lo, explanationTerm);
+    }
+
+    AssumptionTerm const & getAssumptionTerm(Assumption a) const { return assumptionTerms.at(a); }
+
+    void addAssumptionTerm(AssumptionTerm const & term) {
+        switch (term.kind) {
+            case AssumptionTerm::Kind::upper:
+                addUpperBound(term.layer, term.var, term.hi);
+                return;
+            case AssumptionTerm::Kind::lower:
+                addLowerBound(term.layer, term.var, term.lo);
+                return;
+            case AssumptionTerm::Kind::equality:
+                addEquality(term.layer, term.var, term.lo);
+                return;
+            case AssumptionTerm::Kind::interval:
+                addInterval(term.layer, term.var, term.lo, term.hi);
+                return;
+        }
+    }
+
+    void setInputModel(std::vector<float> model) { inputModel = std::move(model); }
+
     std::size_t checksCount{};
 
+    Budget checkBudget{};
+    // Must be set by the verifiers that support the budgets
+    bool checkInterrupted{};
+    // Must be updated by the verifiers that support the conflict limits
+    std::size_t conflictsCount{};
+
+    std::vector<AssumptionTerm> assumptionTerms{};
+
+    std::vector<float> inputModel{};
+    bool _produceInputModels{};
+
+    std::size_t termsCount{};
+    std::vector<std::size_t> termsCountStack{};
+
+    Tracer * tracerPtr{};
+
 private:
+    Tracer::Clock::time_point traceStart() const {
+        return tracerPtr ? Tracer::Clock::now() : Tracer::Clock::time_point{};
+    }
+    void trace(Tracer::CallInfo info) {
+        if (not tracerPtr) { return; }
+        info.end = Tracer::Clock::now();
+        tracerPtr->traceCall(info);
+    }
+
     virtual void pushImpl() = 0;
     virtual void popImpl() = 0;
 
     virtual Answer checkImpl() = 0;
+
+    Assumption addAssumption(AssumptionTerm const & term) {
+        Assumption const a = assumptionTerms.size();
+        assumptionTerms.push_back(term);
+        addAssumptionImpl(term);
+        return a;
+    }
+
+    // By default, the assumptions are just recorded and asserted within a temporary level
+    virtual void addAssumptionImpl(AssumptionTerm const &) {}
+    virtual Answer checkAssumingImpl(Assumptions const & assumptions) {
+        push();
+        for (Assumption a : assumptions) {
+            addAssumptionTerm(getAssumptionTerm(a));
+        }
+        Answer const answer = checkImpl();
+        pop();
+        return answer;
+    }
 };
 } // namespace xai::verifiers
 
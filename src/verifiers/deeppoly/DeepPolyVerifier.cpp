@@ -0,0 +1,510 @@
+#include "DeepPolyVerifier.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace xai::verifiers {
+
+class DeepPolyVerifier::DeepPolyImpl {
+public:
+    void loadModel(nn::NNet const & network);
+
+    void addUpperBound(LayerIndex layer, NodeIndex node, float value);
+    void addLowerBound(LayerIndex layer, NodeIndex node, float value);
+    void addAssumptionTerm(AssumptionTerm const &);
+
+    void addClassificationConstraint(NodeIndex node, float threshold);
+
+    void push();
+    void pop();
+
+    Answer check();
+
+    void reset();
+
+private:
+    // Previous bounds of a node, to be restored on pop
+    struct BoundChange {
+        bool isOutput;
+        NodeIndex node;
+        float lower;
+        float upper;
+    };
+
+    struct Frame {
+        std::size_t trailSize;
+        std::size_t classificationConstraintsSize;
+    };
+
+    struct ClassificationConstraint {
+        NodeIndex node;
+        float threshold;
+    };
+
+    // lowerSlope * x <= relu(x) <= upperSlope * x + upperIntercept
+    struct ReluRelaxation {
+        double upperSlope;
+        double upperIntercept;
+        double lowerSlope;
+    };
+
+    // Row-major matrix of the coefficients of linear expressions, one row per expression
+    struct LinearExpressions {
+        std::size_t rows;
+        std::vector<double> coefs;
+        std::vector<double> consts;
+    };
+
+    nn::NNet const & getNetwork() const {
+        assert(networkPtr);
+        return *networkPtr;
+    }
+
+    LayerIndex getOutputLayer() const { return getNetwork().getNumLayers() - 1; }
+
+    bool isOutputLayer(LayerIndex layer) const {
+        if (layer != 0 and layer != getOutputLayer()) { throw std::logic_error("Unimplemented!"); }
+        return layer != 0;
+    }
+
+    void setBounds(bool isOutput, NodeIndex node, float lo, float hi);
+
+    LinearExpressions makeLayerExpressions(LayerIndex layer) const;
+
+    void computeRelaxations();
+
+    // Bounds of the expressions over the neurons of the given layer (after ReLU), or over the inputs if it is 0
+    std::vector<double> computeBounds(LayerIndex layer, LinearExpressions, bool upper) const;
+
+    bool provesUnsat();
+
+    nn::NNet const * networkPtr{};
+
+    std::vector<float> inputLower;
+    std::vector<float> inputUpper;
+    std::vector<float> outputLower;
+    std::vector<float> outputUpper;
+
+    std::vector<ClassificationConstraint> classificationConstraints;
+
+    std::vector<BoundChange> trail;
+    std::vector<Frame> frames;
+
+    // Indexed by layers, the input and output layers are left empty
+    std::vector<std::vector<ReluRelaxation>> relaxations;
+};
+
+DeepPolyVerifier::DeepPolyVerifier() : pimpl{std::make_unique<DeepPolyImpl>()} {}
+
+DeepPolyVerifier::DeepPolyVerifier(std::unique_ptr<Verifier> fallback) : DeepPolyVerifier() {
+    fallbackPtr = std::move(fallback);
+}
+
+DeepPolyVerifier::~DeepPolyVerifier() {}
+
+void DeepPolyVerifier::loadModelImpl(nn::NNet const & network) {
+    pimpl->loadModel(network);
+    if (fallbackPtr) { fallbackPtr->loadModel(network); }
+}
+
+void DeepPolyVerifier::addUpperBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) {
+    pimpl->addUpperBound(layer, var, value);
+    if (fallbackPtr) { fallbackPtr->addUpperBound(layer, var, value, explanationTerm); }
+}
+
+void DeepPolyVerifier::addLowerBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) {
+    pimpl->addLowerBound(layer, var, value);
+    if (fallbackPtr) { fallbackPtr->addLowerBound(layer, var, value, explanationTerm); }
+}
+
+void DeepPolyVerifier::addClassificationConstraint(NodeIndex node, float threshold) {
+    pimpl->addClassificationConstraint(node, threshold);
+    if (fallbackPtr) { fallbackPtr->addClassificationConstraint(node, threshold); }
+}
+
+void DeepPolyVerifier::addConstraint(LayerIndex, std::vector<std::pair<NodeIndex, int>>, float) {
+    throw std::logic_error("Unimplemented!");
+}
+
+void DeepPolyVerifier::setCheckBudget(Budget const & budget) {
+    if (fallbackPtr) { fallbackPtr->setCheckBudget(budget); }
+    Verifier::setCheckBudget(budget);
+}
+
+void DeepPolyVerifier::resetSampleQuery() {
+    if (fallbackPtr) { fallbackPtr->resetSampleQuery(); }
+    Verifier::resetSampleQuery();
+}
+
+void DeepPolyVerifier::resetSample() {
+    if (fallbackPtr) { fallbackPtr->resetSample(); }
+    Verifier::resetSample();
+}
+
+void DeepPolyVerifier::reset() {
+    pimpl->reset();
+    if (fallbackPtr) { fallbackPtr->reset(); }
+    Verifier::reset();
+}
+
+void DeepPolyVerifier::initImpl() {
+    if (fallbackPtr) { fallbackPtr->init(); }
+}
+
+void DeepPolyVerifier::pushImpl() {
+    pimpl->push();
+    if (fallbackPtr) { fallbackPtr->push(); }
+}
+
+void DeepPolyVerifier::popImpl() {
+    pimpl->pop();
+    if (fallbackPtr) { fallbackPtr->pop(); }
+}
+
+Verifier::Answer DeepPolyVerifier::checkImpl() {
+    Answer const answer = pimpl->check();
+    if (answer == Answer::UNSAT or not fallbackPtr) { return answer; }
+
+    Answer const fallbackAnswer = fallbackPtr->check();
+    setInputModel(fallbackPtr->getInputModel());
+    conflictsCount = fallbackPtr->getConflictsCount();
+    checkInterrupted = fallbackPtr->lastCheckInterrupted();
+    return fallbackAnswer;
+}
+
+void DeepPolyVerifier::produceInputModels(bool produce) {
+    Verifier::produceInputModels(produce);
+    if (fallbackPtr) { fallbackPtr->produceInputModels(produce); }
+}
+
+void DeepPolyVerifier::addAssumptionImpl(AssumptionTerm const & term) {
+    if (not fallbackPtr) { return; }
+
+    auto & fallback = *fallbackPtr;
+    [[maybe_unused]] Assumption fallbackAssumption{};
+    switch (term.kind) {
+        case AssumptionTerm::Kind::upper:
+            fallbackAssumption = fallback.addUpperBoundAssumption(term.layer, term.var, term.hi);
+            break;
+        case AssumptionTerm::Kind::lower:
+            fallbackAssumption = fallback.addLowerBoundAssumption(term.layer, term.var, term.lo);
+            break;
+        case AssumptionTerm::Kind::equality:
+            fallbackAssumption = fallback.addEqualityAssumption(term.layer, term.var, term.lo);
+            break;
+        case AssumptionTerm::Kind::interval:
+            fallbackAssumption = fallback.addIntervalAssumption(term.layer, term.var, term.lo, term.hi);
+            break;
+    }
+    // Both are reset at the same time
+    assert(fallbackAssumption + 1 == assumptionTerms.size());
+}
+
+Verifier::Answer DeepPolyVerifier::checkAssumingImpl(Assumptions const & assumptions) {
+    auto & impl = *pimpl;
+    impl.push();
+    for (Assumption a : assumptions) {
+        impl.addAssumptionTerm(getAssumptionTerm(a));
+    }
+    Answer const answer = impl.check();
+    impl.pop();
+    if (answer == Answer::UNSAT or not fallbackPtr) { return answer; }
+
+    Answer const fallbackAnswer = fallbackPtr->checkAssuming(assumptions);
+    setInputModel(fallbackPtr->getInputModel());
+    conflictsCount = fallbackPtr->getConflictsCount();
+    checkInterrupted = fallbackPtr->lastCheckInterrupted();
+    return fallbackAnswer;
+}
+
+/*
+ * Actual implementation
+ */
+
+namespace {
+// The computation is in double, the bounds are widened by a conservative margin that covers the rounding errors
+constexpr double relativeError = 1e-9;
+
+constexpr float infinity = std::numeric_limits<float>::infinity();
+} // namespace
+
+void DeepPolyVerifier::DeepPolyImpl::loadModel(nn::NNet const & network) {
+    networkPtr = &network;
+
+    std::size_t const inputSize = network.getInputSize();
+    inputLower.resize(inputSize);
+    inputUpper.resize(inputSize);
+    for (NodeIndex node = 0; node < inputSize; ++node) {
+        inputLower[node] = network.getInputLowerBound(node);
+        inputUpper[node] = network.getInputUpperBound(node);
+    }
+
+    std::size_t const outputSize = network.getLayerSize(getOutputLayer());
+    outputLower.assign(outputSize, -infinity);
+    outputUpper.assign(outputSize, infinity);
+
+    relaxations.resize(network.getNumLayers());
+    for (LayerIndex layer = 1; layer < getOutputLayer(); ++layer) {
+        relaxations[layer].resize(network.getLayerSize(layer));
+    }
+}
+
+void DeepPolyVerifier::DeepPolyImpl::addUpperBound(LayerIndex layer, NodeIndex node, float value) {
+    bool const isOutput = isOutputLayer(layer);
+    auto & lower = isOutput ? outputLower : inputLower;
+    auto & upper = isOutput ? outputUpper : inputUpper;
+    setBounds(isOutput, node, lower.at(node), std::min(upper.at(node), value));
+}
+
+void DeepPolyVerifier::DeepPolyImpl::addLowerBound(LayerIndex layer, NodeIndex node, float value) {
+    bool const isOutput = isOutputLayer(layer);
+    auto & lower = isOutput ? outputLower : inputLower;
+    auto & upper = isOutput ? outputUpper : inputUpper;
+    setBounds(isOutput, node, std::max(lower.at(node), value), upper.at(node));
+}
+
+void DeepPolyVerifier::DeepPolyImpl::addAssumptionTerm(AssumptionTerm const & term) {
+    switch (term.kind) {
+        case AssumptionTerm::Kind::upper:
+            addUpperBound(term.layer, term.var, term.hi);
+            return;
+        case AssumptionTerm::Kind::lower:
+            addLowerBound(term.layer, term.var, term.lo);
+            return;
+        case AssumptionTerm::Kind::equality:
+        case AssumptionTerm::Kind::interval:
+            addLowerBound(term.layer, term.var, term.lo);
+            addUpperBound(term.layer, term.var, term.hi);
+            return;
+    }
+}
+
+void DeepPolyVerifier::DeepPolyImpl::setBounds(bool isOutput, NodeIndex node, float lo, float hi) {
+    auto & lower = isOutput ? outputLower : inputLower;
+    auto & upper = isOutput ? outputUpper : inputUpper;
+    if (not frames.empty()) { trail.push_back({.isOutput = isOutput, .node = node, .lower = lower[node], .upper = upper[node]}); }
+    lower[node] = lo;
+    upper[node] = hi;
+}
+
+void DeepPolyVerifier::DeepPolyImpl::addClassificationConstraint(NodeIndex node, float threshold) {
+    if (node >= getNetwork().getLayerSize(getOutputLayer())) {
+        throw std::out_of_range("Node index is out of range for the outputs.");
+    }
+
+    classificationConstraints.push_back({.node = node, .threshold = threshold});
+}
+
+void DeepPolyVerifier::DeepPolyImpl::push() {
+    frames.push_back({.trailSize = trail.size(), .classificationConstraintsSize = classificationConstraints.size()});
+}
+
+void DeepPolyVerifier::DeepPolyImpl::pop() {
+    assert(not frames.empty());
+    auto const & frame = frames.back();
+
+    assert(frame.trailSize <= trail.size());
+    while (trail.size() > frame.trailSize) {
+        auto const & change = trail.back();
+        auto & lower = change.isOutput ? outputLower : inputLower;
+        auto & upper = change.isOutput ? outputUpper : inputUpper;
+        lower[change.node] = change.lower;
+        upper[change.node] = change.upper;
+        trail.pop_back();
+    }
+
+    assert(frame.classificationConstraintsSize <= classificationConstraints.size());
+    classificationConstraints.resize(frame.classificationConstraintsSize);
+
+    frames.pop_back();
+}
+
+Verifier::Answer DeepPolyVerifier::DeepPolyImpl::check() {
+    return provesUnsat() ? Answer::UNSAT : Answer::UNKNOWN;
+}
+
+void DeepPolyVerifier::DeepPolyImpl::reset() {
+    networkPtr = nullptr;
+    inputLower.clear();
+    inputUpper.clear();
+    outputLower.clear();
+    outputUpper.clear();
+    classificationConstraints.clear();
+    trail.clear();
+    frames.clear();
+    relaxations.clear();
+}
+
+DeepPolyVerifier::DeepPolyImpl::LinearExpressions
+DeepPolyVerifier::DeepPolyImpl::makeLayerExpressions(LayerIndex layer) const {
+    auto const & network = getNetwork();
+    assert(layer > 0);
+    std::size_t const layerSize = network.getLayerSize(layer);
+    std::size_t const prevLayerSize = network.getLayerSize(layer - 1);
+
+    LinearExpressions exprs{.rows = layerSize, .coefs = {}, .consts = {}};
+    exprs.coefs.reserve(layerSize * prevLayerSize);
+    exprs.consts.reserve(layerSize);
+    for (NodeIndex node = 0; node < layerSize; ++node) {
+        auto const & weights = network.getWeights(layer, node);
+        assert(weights.size() == prevLayerSize);
+        exprs.coefs.insert(exprs.coefs.end(), weights.begin(), weights.end());
+        exprs.consts.push_back(network.getBias(layer, node));
+    }
+
+    return exprs;
+}
+
+void DeepPolyVerifier::DeepPolyImpl::computeRelaxations() {
+    for (LayerIndex layer = 1; layer < getOutputLayer(); ++layer) {
+        auto exprs = makeLayerExpressions(layer);
+        auto const lower = computeBounds(layer - 1, exprs, false);
+        auto const upper = computeBounds(layer - 1, std::move(exprs), true);
+
+        auto & layerRelaxations = relaxations[layer];
+        std::size_t const layerSize = layerRelaxations.size();
+        assert(lower.size() == layerSize);
+        assert(upper.size() == layerSize);
+        for (NodeIndex node = 0; node < layerSize; ++node) {
+            double const lo = lower[node];
+            double const hi = upper[node];
+            auto & relaxation = layerRelaxations[node];
+            if (hi <= 0) {
+                relaxation = {.upperSlope = 0, .upperIntercept = 0, .lowerSlope = 0};
+            } else if (lo >= 0) {
+                relaxation = {.upperSlope = 1, .upperIntercept = 0, .lowerSlope = 1};
+            } else {
+                // The lower slope that minimizes the area of the relaxation
+                double const slope = hi / (hi - lo);
+                relaxation = {.upperSlope = slope, .upperIntercept = -slope * lo, .lowerSlope = (hi > -lo) ? 1. : 0.};
+            }
+        }
+    }
+}
+
+std::vector<double> DeepPolyVerifier::DeepPolyImpl::computeBounds(LayerIndex layer, LinearExpressions exprs,
+                                                                  bool upper) const {
+    auto const & network = getNetwork();
+    std::size_t const rows = exprs.rows;
+    auto & coefs = exprs.coefs;
+    auto & consts = exprs.consts;
+
+    // Back-substitution down to the inputs
+    std::vector<double> prevCoefs;
+    for (; layer > 0; --layer) {
+        std::size_t const layerSize = network.getLayerSize(layer);
+        std::size_t const prevLayerSize = network.getLayerSize(layer - 1);
+        assert(coefs.size() == rows * layerSize);
+
+        // Through the ReLUs
+        auto const & layerRelaxations = relaxations[layer];
+        for (std::size_t row = 0; row < rows; ++row) {
+            double * const rowCoefs = coefs.data() + row * layerSize;
+            for (NodeIndex node = 0; node < layerSize; ++node) {
+                double const coef = rowCoefs[node];
+                if (coef == 0) { continue; }
+                auto const & relaxation = layerRelaxations[node];
+                if ((coef > 0) == upper) {
+                    consts[row] += coef * relaxation.upperIntercept;
+                    rowCoefs[node] = coef * relaxation.upperSlope;
+                } else {
+                    rowCoefs[node] = coef * relaxation.lowerSlope;
+                }
+            }
+        }
+
+        // Through the affine transformation
+        prevCoefs.assign(rows * prevLayerSize, 0);
+        for (std::size_t row = 0; row < rows; ++row) {
+            double const * const rowCoefs = coefs.data() + row * layerSize;
+            double * const rowPrevCoefs = prevCoefs.data() + row * prevLayerSize;
+            for (NodeIndex node = 0; node < layerSize; ++node) {
+                double const coef = rowCoefs[node];
+                if (coef == 0) { continue; }
+                consts[row] += coef * network.getBias(layer, node);
+                auto const & weights = network.getWeights(layer, node);
+                for (NodeIndex prevNode = 0; prevNode < prevLayerSize; ++prevNode) {
+                    rowPrevCoefs[prevNode] += coef * weights[prevNode];
+                }
+            }
+        }
+        coefs.swap(prevCoefs);
+    }
+
+    // Concretization over the input box
+    std::size_t const inputSize = inputLower.size();
+    assert(coefs.size() == rows * inputSize);
+    std::vector<double> bounds(rows);
+    for (std::size_t row = 0; row < rows; ++row) {
+        double const * const rowCoefs = coefs.data() + row * inputSize;
+        double bound = consts[row];
+        double magnitude = std::abs(bound);
+        for (NodeIndex node = 0; node < inputSize; ++node) {
+            double const coef = rowCoefs[node];
+            double const val = ((coef > 0) == upper) ? inputUpper[node] : inputLower[node];
+            double const addend = coef * val;
+            bound += addend;
+            magnitude += std::abs(addend);
+        }
+        double const margin = magnitude * relativeError;
+        bounds[row] = upper ? bound + margin : bound - margin;
+    }
+
+    return bounds;
+}
+
+bool DeepPolyVerifier::DeepPolyImpl::provesUnsat() {
+    std::size_t const inputSize = inputLower.size();
+    for (NodeIndex node = 0; node < inputSize; ++node) {
+        if (inputLower[node] > inputUpper[node]) { return true; }
+    }
+
+    computeRelaxations();
+
+    LayerIndex const outputLayer = getOutputLayer();
+    LayerIndex const lastHiddenLayer = outputLayer - 1;
+
+    bool const boundingOutputs =
+        std::ranges::any_of(outputLower, [](float val) { return val > -infinity; }) or
+        std::ranges::any_of(outputUpper, [](float val) { return val < infinity; });
+    if (boundingOutputs) {
+        auto exprs = makeLayerExpressions(outputLayer);
+        auto const lower = computeBounds(lastHiddenLayer, exprs, false);
+        auto const upper = computeBounds(lastHiddenLayer, std::move(exprs), true);
+        std::size_t const outputSize = outputLower.size();
+        for (NodeIndex node = 0; node < outputSize; ++node) {
+            if (lower[node] > outputUpper[node] or upper[node] < outputLower[node]) { return true; }
+        }
+    }
+
+    // Classification constraint: at least one of the other outputs exceeds the given one by the threshold
+    if (classificationConstraints.empty()) { return false; }
+
+    auto const outputExprs = makeLayerExpressions(outputLayer);
+    std::size_t const outputSize = outputExprs.rows;
+    std::size_t const lastHiddenSize = getNetwork().getLayerSize(lastHiddenLayer);
+    for (auto const & [refNode, threshold] : classificationConstraints) {
+        LinearExpressions diffExprs{.rows = outputSize - 1, .coefs = {}, .consts = {}};
+        diffExprs.coefs.reserve(diffExprs.rows * lastHiddenSize);
+        diffExprs.consts.reserve(diffExprs.rows);
+        double const * const refCoefs = outputExprs.coefs.data() + refNode * lastHiddenSize;
+        for (NodeIndex node = 0; node < outputSize; ++node) {
+            if (node == refNode) { continue; }
+            double const * const nodeCoefs = outputExprs.coefs.data() + node * lastHiddenSize;
+            for (NodeIndex i = 0; i < lastHiddenSize; ++i) {
+                diffExprs.coefs.push_back(nodeCoefs[i] - refCoefs[i]);
+            }
+            diffExprs.consts.push_back(outputExprs.consts[node] - outputExprs.consts[refNode]);
+        }
+
+        auto const upper = computeBounds(lastHiddenLayer, std::move(diffExprs), true);
+        if (std::ranges::all_of(upper, [threshold](double val) { return val <= threshold; })) { return true; }
+    }
+
+    return false;
+}
+
+} // namespace xai::verifiers
@@ -0,0 +1,66 @@
+#ifndef XAI_SMT_DEEPPOLYVERIFIER_H
+#define XAI_SMT_DEEPPOLYVERIFIER_H
+
+#include <verifiers/Verifier.h>
+
+#include <memory>
+
+namespace xai::verifiers {
+
+// Incomplete verifier based on abstract interpretation with linear relaxations of ReLUs (DeepPoly)
+// It answers UNSAT if it proves that the constraints cannot be satisfied, and UNKNOWN otherwise,
+// unless a fallback verifier is given, which then decides the queries that were not proven
+// Supports bounds of the inputs and of the outputs, and classification constraints
+class DeepPolyVerifier : public Verifier {
+public:
+    DeepPolyVerifier();
+    explicit DeepPolyVerifier(std::unique_ptr<Verifier> fallback);
+    virtual ~DeepPolyVerifier();
+    DeepPolyVerifier(DeepPolyVerifier const &) = delete;
+    DeepPolyVerifier & operator=(DeepPolyVerifier const &) = delete;
+    DeepPolyVerifier(DeepPolyVerifier &&) = default;
+    DeepPolyVerifier & operator=(DeepPolyVerifier &&) = default;
+
+    bool hasFallback() const { return bool(fallbackPtr); }
+
+    void addClassificationConstraint(NodeIndex node, float threshold) override;
+
+    void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, float rhs) override;
+
+    // Only the fallback verifier uses the budget
+    void setCheckBudget(Budget const &) override;
+
+    void resetSampleQuery() override;
+    void resetSample() override;
+    void reset() override;
+
+    // Only the fallback verifier can provide the models
+    void produceInputModels(bool produce = true) override;
+
+protected:
+    void initImpl() override;
+
+    void loadModelImpl(nn::NNet const & network) override;
+
+    void addUpperBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) override;
+    void addLowerBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) override;
+
+    void pushImpl() override;
+    void popImpl() override;
+
+    Answer checkImpl() override;
+
+    // The assumptions are also passed to the fallback verifier, if any
+    void addAssumptionImpl(AssumptionTerm const &) override;
+    Answer checkAssumingImpl(Assumptions const &) override;
+
+private:
+    class DeepPolyImpl;
+    std::unique_ptr<DeepPolyImpl> pimpl;
+
+    std::unique_ptr<Verifier> fallbackPtr;
+};
+
+} // namespace xai::verifiers
+
+#endif // XAI_SMT_DEEPPOLYVERIFIER_H
@@ -76,25 +76,28 @@ public:
     void push();
     void pop();
 
-    Answer check();
+    // Unlimited if the timeout is zero
+    Answer check(double timeout);
+    bool hasLastCheckTimedOut() const { return lastCheckTimedOut; }
 
 private:
     std::unique_ptr<QueryIncrementalWrapper> queryWrapper;
+    bool lastCheckTimedOut{};
 };
 
 MarabouVerifier::MarabouVerifier() : pimpl{std::make_unique<MarabouImpl>()} {}
 
 MarabouVerifier::~MarabouVerifier() {}
 
-void MarabouVerifier::loadModel(nn::NNet const & network) {
+void MarabouVerifier::loadModelImpl(nn::NNet const & network) {
     pimpl->loadModel(network);
 }
 
-void MarabouVerifier::addUpperBound(LayerIndex layer, NodeIndex var, float value, bool /*explanationTerm*/) {
+void MarabouVerifier::addUpperBoundImpl(LayerIndex layer, NodeIndex var, float value, bool /*explanationTerm*/) {
     pimpl->addUpperBound(layer, var, value);
 }
 
-void MarabouVerifier::addLowerBound(LayerIndex layer, NodeIndex var, float value, bool /*explanationTerm*/) {
+void MarabouVerifier::addLowerBoundImpl(LayerIndex layer, NodeIndex var, float value, bool /*explanationTerm*/) {
     pimpl->addLowerBound(layer, var, value);
 }
 
@@ -115,7 +118,10 @@ void MarabouVerifier::popImpl() {
 }
 
 Verifier::Answer MarabouVerifier::checkImpl() {
-    return pimpl->check();
+    // The conflict limit is not supported
+    Answer const answer = pimpl->check(getCheckBudget().timeout);
+    checkInterrupted = pimpl->hasLastCheckTimedOut();
+    return answer;
 }
 
 /*
@@ -358,23 +364,27 @@ Verifier::Answer toAnswer(Engine::ExitCode exitCode) {
             return Verifier::Answer::UNKNOWN;
         case Engine::ExitCode::ERROR:
             return Verifier::Answer::ERROR;
+        case Engine::ExitCode::TIMEOUT:
+            return Verifier::Answer::UNKNOWN;
         default:
             return Verifier::Answer::UNKNOWN;
     }
 }
 }
 
-Verifier::Answer MarabouVerifier::MarabouImpl::check() {
+Verifier::Answer MarabouVerifier::MarabouImpl::check(double timeout) {
     auto queryPtr = queryWrapper->buildQuery();
     auto & query = *queryPtr;
     Engine engine;
+    lastCheckTimedOut = false;
     bool continueWithSolving = engine.processInputQuery(query, true);
     if (not continueWithSolving) {
         return toAnswer(engine.getExitCode());
     }
-    bool feasible = engine.solve();
+    bool feasible = engine.solve(timeout);
     auto exitCode = engine.getExitCode();
     assert(feasible == (exitCode == Engine::ExitCode::SAT));
+    lastCheckTimedOut = (exitCode == Engine::ExitCode::TIMEOUT);
     return toAnswer(exitCode);
 }
 
@@ -16,17 +16,17 @@ public:
     MarabouVerifier(MarabouVerifier &&) = default;
     MarabouVerifier & operator=(MarabouVerifier &&) = default;
 
-    void loadModel(nn::NNet const & network) override;
-
-    void addUpperBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) override;
-
-    void addLowerBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) override;
-
     void addClassificationConstraint(NodeIndex node, float threshold) override;
 
     void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, float rhs) override;
 
 protected:
+    void loadModelImpl(nn::NNet const & network) override;
+
+    void addUpperBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) override;
+
+    void addLowerBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) override;
+
     void pushImpl() override;
     void popImpl() override;
 
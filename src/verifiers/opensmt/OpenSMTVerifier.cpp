@@ -1,11 +1,15 @@
 #include "OpenSMTVerifier.h"
 
 #include <api/MainSolver.h>
-#include <common/StringConv.h>
 #include <logics/ArithLogic.h>
 #include <logics/LogicFactory.h>
 
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <ranges>
 #include <string>
 #include <unordered_map>
@@ -14,33 +18,28 @@ namespace xai::verifiers {
 
 using namespace opensmt;
 
-namespace { // Helper methods
-FastRational floatToRational(float value);
-}
-
 class OpenSMTVerifier::OpenSMTImpl {
 public:
     void loadModel(nn::NNet const & network);
 
     PTRef makeUpperBound(LayerIndex layer, NodeIndex node, float value) {
-        return makeUpperBound(layer, node, floatToRational(value));
+        return makeUpperBound(layer, node, makeRealConst(value));
     }
     PTRef makeLowerBound(LayerIndex layer, NodeIndex node, float value) {
-        return makeLowerBound(layer, node, floatToRational(value));
+        return makeLowerBound(layer, node, makeRealConst(value));
     }
     PTRef makeEquality(LayerIndex layer, NodeIndex node, float value) {
-        return makeEquality(layer, node, floatToRational(value));
+        return makeEquality(layer, node, makeRealConst(value));
     }
     PTRef makeInterval(LayerIndex layer, NodeIndex node, float lo, float hi) {
-        return makeInterval(layer, node, floatToRational(lo), floatToRational(hi));
+        return makeInterval(layer, node, makeRealConst(lo), makeRealConst(hi));
     }
-    PTRef makeUpperBound(LayerIndex layer, NodeIndex node, FastRational value);
-    PTRef makeLowerBound(LayerIndex layer, NodeIndex node, FastRational value);
-    PTRef makeEquality(LayerIndex layer, NodeIndex node, FastRational value) {
-        FastRational valueCp = value;
-        return makeInterval(layer, node, std::move(value), std::move(valueCp));
+    PTRef makeUpperBound(LayerIndex layer, NodeIndex node, PTRef valueTerm);
+    PTRef makeLowerBound(LayerIndex layer, NodeIndex node, PTRef valueTerm);
+    PTRef makeEquality(LayerIndex layer, NodeIndex node, PTRef valueTerm) {
+        return makeInterval(layer, node, valueTerm, valueTerm);
     }
-    PTRef makeInterval(LayerIndex layer, NodeIndex node, FastRational lo, FastRational hi);
+    PTRef makeInterval(LayerIndex layer, NodeIndex node, PTRef loTerm, PTRef hiTerm);
 
     PTRef addUpperBound(LayerIndex layer, NodeIndex node, float value, bool explanationTerm = false);
     PTRef addLowerBound(LayerIndex layer, NodeIndex node, float value, bool explanationTerm = false);
@@ -51,12 +50,20 @@ public:
 
     void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, float rhs);
 
+    void addAssumption(AssumptionTerm const &);
+
     void init();
 
     void push();
     void pop();
 
-    Answer check();
+    // If given, the input model is stored there in the case of SAT
+    Answer check(std::vector<float> * inputModelPtr = nullptr);
+    Answer checkAssuming(Assumptions const &, std::vector<float> * inputModelPtr = nullptr);
+
+    void setBudget(Budget const & b) { budget = b; }
+    std::size_t getLastCheckConflicts() const { return lastCheckConflicts; }
+    bool wasLastCheckInterrupted() const { return lastCheckInterrupted; }
 
     void resetSampleQuery();
     void resetSample();
@@ -68,6 +75,18 @@ public:
     opensmt::MainSolver & getSolver() { return *solver; }
 
 private:
+    // The time limit is only checked between chunks of conflicts, as it is not supported by the solver directly
+    // Each further chunk continues with what the solver learned in the previous ones
+    static constexpr std::uint64_t timeLimitConflictsChunk = 1000;
+
+    sstat checkWithinBudget();
+
+    // Repeated values (e.g. weights) share one term and are converted only once
+    PTRef makeRealConst(float value);
+
+    // Must be called right after a check that answered SAT
+    std::vector<float> makeInputModel() const;
+
     static std::string makeTermName(LayerIndex layer, NodeIndex node, std::string prefix = "") {
         assert(layer == 0);
         return prefix + "n" + std::to_string(node);
@@ -93,29 +112,39 @@ private:
     std::unordered_map<PTRef, NodeIndex, PTRefHash> inputVarUpperBoundToIndex;
     std::unordered_map<PTRef, NodeIndex, PTRefHash> inputVarEqualityToIndex;
     std::unordered_map<PTRef, NodeIndex, PTRefHash> inputVarIntervalToIndex;
+
+    std::vector<PTRef> assumptionGuards;
+    std::size_t assumptionGuardsCounter{};
+
+    // Keyed by the bits of the float value
+    std::unordered_map<std::uint32_t, PTRef> realConstCache;
+
+    Budget budget{};
+    std::size_t lastCheckConflicts{};
+    bool lastCheckInterrupted{};
 };
 
 OpenSMTVerifier::OpenSMTVerifier() : pimpl{std::make_unique<OpenSMTImpl>()} {}
 
 OpenSMTVerifier::~OpenSMTVerifier() {}
 
-void OpenSMTVerifier::loadModel(nn::NNet const & network) {
+void OpenSMTVerifier::loadModelImpl(nn::NNet const & network) {
     pimpl->loadModel(network);
 }
 
-void OpenSMTVerifier::addUpperBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) {
+void OpenSMTVerifier::addUpperBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) {
     pimpl->addUpperBound(layer, var, value, explanationTerm);
 }
 
-void OpenSMTVerifier::addLowerBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) {
+void OpenSMTVerifier::addLowerBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) {
     pimpl->addLowerBound(layer, var, value, explanationTerm);
 }
 
-void OpenSMTVerifier::addEquality(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) {
+void OpenSMTVerifier::addEqualityImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) {
     pimpl->addEquality(layer, var, value, explanationTerm);
 }
 
-void OpenSMTVerifier::addInterval(LayerIndex layer, NodeIndex var, float lo, float hi, bool explanationTerm) {
+void OpenSMTVerifier::addIntervalImpl(LayerIndex layer, NodeIndex var, float lo, float hi, bool explanationTerm) {
     pimpl->addInterval(layer, var, lo, hi, explanationTerm);
 }
 
@@ -140,7 +169,30 @@ void OpenSMTVerifier::popImpl() {
 }
 
 Verifier::Answer OpenSMTVerifier::checkImpl() {
-    return pimpl->check();
+    std::vector<float> model;
+    auto const answer = pimpl->check(producingInputModels() ? &model : nullptr);
+    conflictsCount += pimpl->getLastCheckConflicts();
+    checkInterrupted = pimpl->wasLastCheckInterrupted();
+    if (producingInputModels()) { setInputModel(std::move(model)); }
+    return answer;
+}
+
+void OpenSMTVerifier::addAssumptionImpl(AssumptionTerm const & term) {
+    pimpl->addAssumption(term);
+}
+
+Verifier::Answer OpenSMTVerifier::checkAssumingImpl(Assumptions const & assumptions) {
+    std::vector<float> model;
+    auto const answer = pimpl->checkAssuming(assumptions, producingInputModels() ? &model : nullptr);
+    conflictsCount += pimpl->getLastCheckConflicts();
+    checkInterrupted = pimpl->wasLastCheckInterrupted();
+    if (producingInputModels()) { setInputModel(std::move(model)); }
+    return answer;
+}
+
+void OpenSMTVerifier::setCheckBudget(Budget const & budget) {
+    pimpl->setBudget(budget);
+    UnsatCoreVerifier::setCheckBudget(budget);
 }
 
 void OpenSMTVerifier::resetSampleQuery() {
@@ -173,16 +225,51 @@ opensmt::MainSolver & OpenSMTVerifier::getSolver() {
  * Actual implementation
  */
 
-namespace { // Helper methods
+// Exact conversion, without going through a decimal string
 FastRational floatToRational(float value) {
-    auto s = std::to_string(value);
-    char* rationalString;
-    opensmt::stringToRational(rationalString, s.c_str());
-    auto res = FastRational(rationalString);
-    free(rationalString);
+    assert(std::isfinite(value));
+    if (value == 0) { return 0; }
+
+    // value = mantissa * 2^exp, with 0.5 <= |mantissa| < 1
+    int exp;
+    float const mantissa = std::frexp(value, &exp);
+
+    // The scaled mantissa is exactly an integer since it fits into the digits of float
+    constexpr int mantissaDigits = std::numeric_limits<float>::digits;
+    static_assert(mantissaDigits < 31);
+    auto num = static_cast<std::int32_t>(std::ldexp(mantissa, mantissaDigits));
+    exp -= mantissaDigits;
+
+    // Make the numerator odd so that the fraction is already normalized
+    int const trailingZeros = std::countr_zero(static_cast<std::uint32_t>(num));
+    num >>= trailingZeros;
+    exp += trailingZeros;
+
+    constexpr int maxShift = 30;
+    // The most common case: no numbers beyond machine words
+    if (exp <= 0 and exp >= -maxShift) { return FastRational(num, std::uint32_t{1} << -exp); }
+    if (exp > 0 and exp <= maxShift and std::abs(num) < (std::int32_t{1} << (maxShift - exp))) {
+        return FastRational(num * (std::int32_t{1} << exp));
+    }
+
+    // Otherwise scale by powers of two that fit into machine words
+    FastRational res(num);
+    FastRational const maxShiftFactor(std::int32_t{1} << maxShift);
+    for (; exp > maxShift; exp -= maxShift) {
+        res *= maxShiftFactor;
+    }
+    for (; exp < -maxShift; exp += maxShift) {
+        res /= maxShiftFactor;
+    }
+    if (exp > 0) {
+        res *= FastRational(std::int32_t{1} << exp);
+    } else if (exp < 0) {
+        res /= FastRational(std::int32_t{1} << -exp);
+    }
     return res;
 }
 
+namespace { // Helper methods
 Verifier::Answer toAnswer(sstat res) {
     if (res == s_False)
         return Verifier::Answer::UNSAT;
@@ -212,12 +299,12 @@ void OpenSMTVerifier::OpenSMTImpl::loadModel(nn::NNet const & network) {
             std::vector<PTRef> addends;
             float bias = network.getBias(layer, node);
             auto const & weights = network.getWeights(layer, node);
-            PTRef biasTerm = logic->mkRealConst(floatToRational(bias));
+            PTRef biasTerm = makeRealConst(bias);
             addends.push_back(biasTerm);
 
             assert(previousLayerRefs.size() == weights.size());
             for (int j = 0; j < weights.size(); j++) {
-                PTRef weightTerm = logic->mkRealConst(floatToRational(weights[j]));
+                PTRef weightTerm = makeRealConst(weights[j]);
                 PTRef addend = logic->mkTimes(weightTerm, previousLayerRefs[j]);
                 addends.push_back(addend);
             }
@@ -237,12 +324,12 @@ void OpenSMTVerifier::OpenSMTImpl::loadModel(nn::NNet const & network) {
         std::vector<PTRef> addends;
         float bias = network.getBias(lastLayerIndex, node);
         auto const & weights = network.getWeights(lastLayerIndex, node);
-        PTRef biasTerm = logic->mkRealConst(floatToRational(bias));
+        PTRef biasTerm = makeRealConst(bias);
         addends.push_back(biasTerm);
 
         assert(previousLayerRefs.size() == weights.size());
         for (int j = 0; j < weights.size(); j++) {
-            PTRef weightTerm = logic->mkRealConst(floatToRational(weights[j]));
+            PTRef weightTerm = makeRealConst(weights[j]);
             PTRef addend = logic->mkTimes(weightTerm, previousLayerRefs[j]);
             addends.push_back(addend);
         }
@@ -260,29 +347,35 @@ void OpenSMTVerifier::OpenSMTImpl::loadModel(nn::NNet const & network) {
     for (NodeIndex i = 0; i < network.getLayerSize(0); ++i) {
         float lb = network.getInputLowerBound(i);
         float ub = network.getInputUpperBound(i);
-        bounds.push_back(logic->mkGeq(inputVars[i], logic->mkRealConst(floatToRational(lb))));
-        bounds.push_back(logic->mkLeq(inputVars[i], logic->mkRealConst(floatToRational(ub))));
+        bounds.push_back(logic->mkGeq(inputVars[i], makeRealConst(lb)));
+        bounds.push_back(logic->mkLeq(inputVars[i], makeRealConst(ub)));
     }
     solver->addAssertion(logic->mkAnd(bounds));
 }
 
-PTRef OpenSMTVerifier::OpenSMTImpl::makeUpperBound(LayerIndex layer, NodeIndex node, FastRational value) {
+PTRef OpenSMTVerifier::OpenSMTImpl::makeRealConst(float value) {
+    auto const [it, inserted] = realConstCache.try_emplace(std::bit_cast<std::uint32_t>(value));
+    if (inserted) { it->second = logic->mkRealConst(floatToRational(value)); }
+    return it->second;
+}
+
+PTRef OpenSMTVerifier::OpenSMTImpl::makeUpperBound(LayerIndex layer, NodeIndex node, PTRef valueTerm) {
     if (layer != 0 and layer != layerSizes.size() - 1)
         throw std::logic_error("Unimplemented!");
     PTRef var = layer == 0 ? inputVars.at(node) : outputVars.at(node);
-    return logic->mkLeq(var, logic->mkRealConst(value));
+    return logic->mkLeq(var, valueTerm);
 }
 
-PTRef OpenSMTVerifier::OpenSMTImpl::makeLowerBound(LayerIndex layer, NodeIndex node, FastRational value) {
+PTRef OpenSMTVerifier::OpenSMTImpl::makeLowerBound(LayerIndex layer, NodeIndex node, PTRef valueTerm) {
     if (layer != 0 and layer != layerSizes.size() - 1)
         throw std::logic_error("Unimplemented!");
     PTRef var = layer == 0 ? inputVars.at(node) : outputVars.at(node);
-    return logic->mkGeq(var, logic->mkRealConst(value));
+    return logic->mkGeq(var, valueTerm);
 }
 
-PTRef OpenSMTVerifier::OpenSMTImpl::makeInterval(LayerIndex layer, NodeIndex node, FastRational lo, FastRational hi) {
-    PTRef lterm = makeLowerBound(layer, node, std::move(lo));
-    PTRef uterm = makeUpperBound(layer, node, std::move(hi));
+PTRef OpenSMTVerifier::OpenSMTImpl::makeInterval(LayerIndex layer, NodeIndex node, PTRef loTerm, PTRef hiTerm) {
+    PTRef lterm = makeLowerBound(layer, node, loTerm);
+    PTRef uterm = makeUpperBound(layer, node, hiTerm);
     return logic->mkAnd(lterm, uterm);
 }
 
@@ -347,7 +440,7 @@ void OpenSMTVerifier::OpenSMTImpl::addClassificationConstraint(NodeIndex node, f
         if (i != node) {
             // Create a constraint: (targetNodeVar - outputVars[i]) > threshold
             PTRef diff = logic->mkMinus(outputVars[i], targetNodeVar);
-            PTRef thresholdConst = logic->mkRealConst(floatToRational(threshold));
+            PTRef thresholdConst = makeRealConst(threshold);
             PTRef constraint = logic->mkGt(diff, thresholdConst);
             constraints.push_back(constraint);
         }
@@ -364,6 +457,30 @@ OpenSMTVerifier::OpenSMTImpl::addConstraint(LayerIndex layer, std::vector<std::p
     throw std::logic_error("Unimplemented!");
 }
 
+void OpenSMTVerifier::OpenSMTImpl::addAssumption(AssumptionTerm const & term) {
+    PTRef phi = PTRef_Undef;
+    switch (term.kind) {
+        case AssumptionTerm::Kind::upper:
+            phi = makeUpperBound(term.layer, term.var, term.hi);
+            break;
+        case AssumptionTerm::Kind::lower:
+            phi = makeLowerBound(term.layer, term.var, term.lo);
+            break;
+        case AssumptionTerm::Kind::equality:
+            phi = makeEquality(term.layer, term.var, term.lo);
+            break;
+        case AssumptionTerm::Kind::interval:
+            phi = makeInterval(term.layer, term.var, term.lo, term.hi);
+            break;
+    }
+
+    // Names of the guards are never reused within the same logic
+    auto const guardName = "a_" + std::to_string(assumptionGuardsCounter++);
+    PTRef guard = logic->mkBoolVar(guardName.c_str());
+    solver->addAssertion(logic->mkImpl(guard, phi));
+    assumptionGuards.push_back(guard);
+}
+
 void OpenSMTVerifier::OpenSMTImpl::push() {
     solver->push();
 }
@@ -372,9 +489,87 @@ void OpenSMTVerifier::OpenSMTImpl::pop() {
     solver->pop();
 }
 
-Verifier::Answer OpenSMTVerifier::OpenSMTImpl::check() {
-    auto res = solver->check();
-    return toAnswer(res);
+Verifier::Answer OpenSMTVerifier::OpenSMTImpl::check(std::vector<float> * inputModelPtr) {
+    auto res = checkWithinBudget();
+    auto const answer = toAnswer(res);
+    if (inputModelPtr and answer == Answer::SAT) { *inputModelPtr = makeInputModel(); }
+    return answer;
+}
+
+Verifier::Answer OpenSMTVerifier::OpenSMTImpl::checkAssuming(Assumptions const & assumptions,
+                                                             std::vector<float> * inputModelPtr) {
+    // Only the unit guards are asserted at the temporary level, the guarded terms stay in the solver
+    solver->push();
+    for (Assumption a : assumptions) {
+        solver->addAssertion(assumptionGuards.at(a));
+    }
+    auto res = checkWithinBudget();
+    auto const answer = toAnswer(res);
+    // The model is no longer available after the pop
+    if (inputModelPtr and answer == Answer::SAT) { *inputModelPtr = makeInputModel(); }
+    solver->pop();
+    return answer;
+}
+
+sstat OpenSMTVerifier::OpenSMTImpl::checkWithinBudget() {
+    auto & satSolver = solver->getSMTSolver();
+    std::uint64_t const conflictsBefore = satSolver.conflicts;
+    auto const usedConflicts = [&] { return satSolver.conflicts - conflictsBefore; };
+
+    bool const limitingTime = (budget.timeout > 0);
+    bool const limitingConflicts = (budget.conflicts > 0);
+    // The stop requests are also only noticed between the chunks of conflicts
+    bool const stoppable = budget.stopToken.stop_possible();
+    lastCheckInterrupted = false;
+    if (not limitingTime and not limitingConflicts and not stoppable) {
+        auto const res = solver->check();
+        lastCheckConflicts = usedConflicts();
+        return res;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto const deadline = Clock::now() + std::chrono::duration<double>(budget.timeout);
+    sstat res = s_Undef;
+    while (true) {
+        std::uint64_t const used = usedConflicts();
+        std::uint64_t chunk = (limitingTime or stoppable) ? timeLimitConflictsChunk : budget.conflicts;
+        if (limitingConflicts) {
+            if (used >= budget.conflicts) {
+                lastCheckInterrupted = true;
+                break;
+            }
+            chunk = std::min<std::uint64_t>(chunk, budget.conflicts - used);
+        }
+
+        satSolver.setConfBudget(chunk);
+        res = solver->check();
+        if (res != s_Undef) { break; }
+        // Also prevents looping if the solver gives up for another reason
+        if (usedConflicts() == used) { break; }
+        // Otherwise, the chunk of conflicts was exhausted
+        bool const exhausted = budget.stopToken.stop_requested() or (limitingTime and Clock::now() >= deadline) or
+                               (not limitingTime and not stoppable);
+        if (exhausted) {
+            lastCheckInterrupted = true;
+            break;
+        }
+    }
+    satSolver.budgetOff();
+
+    lastCheckConflicts = usedConflicts();
+    return res;
+}
+
+std::vector<float> OpenSMTVerifier::OpenSMTImpl::makeInputModel() const {
+    auto const model = solver->getModel();
+    std::vector<float> values;
+    values.reserve(inputVars.size());
+    for (PTRef var : inputVars) {
+        PTRef const value = model->evaluate(var);
+        assert(logic->isNumConst(value));
+        values.push_back(static_cast<float>(logic->getNumConst(value).get_d()));
+    }
+    return values;
 }
 
 void OpenSMTVerifier::OpenSMTImpl::init() {
@@ -393,6 +588,8 @@ void OpenSMTVerifier::OpenSMTImpl::resetSampleQuery() {
     inputVarUpperBoundToIndex.clear();
     inputVarEqualityToIndex.clear();
     inputVarIntervalToIndex.clear();
+
+    assumptionGuards.clear();
 }
 
 void OpenSMTVerifier::OpenSMTImpl::resetSample() {
@@ -404,6 +601,8 @@ void OpenSMTVerifier::OpenSMTImpl::reset() {
     solver = std::make_unique<MainSolver>(*logic, *config, "verifier");
     inputVars.clear();
     outputVars.clear();
+    assumptionGuardsCounter = 0;
+    realConstCache.clear();
 
     // resetSample() is called by Verifier
 }
@@ -7,6 +7,7 @@
 
 namespace opensmt {
 class MainSolver;
+class FastRational;
 }
 
 namespace xai::verifiers {
@@ -20,18 +21,12 @@ public:
     OpenSMTVerifier(OpenSMTVerifier &&) = default;
     OpenSMTVerifier & operator=(OpenSMTVerifier &&) = default;
 
-    void loadModel(nn::NNet const & network) override;
-
-    void addUpperBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) override;
-    void addLowerBound(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) override;
-    // Ensure that equalities and intervals correspond to just one assertion
-    void addEquality(LayerIndex layer, NodeIndex var, float value, bool explanationTerm = false) override;
-    void addInterval(LayerIndex layer, NodeIndex var, float lo, float hi, bool explanationTerm = false) override;
-
     void addClassificationConstraint(NodeIndex node, float threshold) override;
 
     void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, float rhs) override;
 
+    void setCheckBudget(Budget const &) override;
+
     void resetSampleQuery() override;
     void resetSample() override;
     void reset() override;
@@ -44,16 +39,32 @@ public:
 protected:
     void initImpl() override;
 
+    void loadModelImpl(nn::NNet const & network) override;
+
+    void addUpperBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) override;
+    void addLowerBoundImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) override;
+    // Ensure that equalities and intervals correspond to just one assertion
+    void addEqualityImpl(LayerIndex layer, NodeIndex var, float value, bool explanationTerm) override;
+    void addIntervalImpl(LayerIndex layer, NodeIndex var, float lo, float hi, bool explanationTerm) override;
+
     void pushImpl() override;
     void popImpl() override;
 
     Answer checkImpl() override;
 
+    // Each assumption is guarded by a fresh Boolean variable and the checks only assert the guards,
+    // hence the solver can keep what it learned across the checks
+    void addAssumptionImpl(AssumptionTerm const &) override;
+    Answer checkAssumingImpl(Assumptions const &) override;
+
 private:
     class OpenSMTImpl;
     std::unique_ptr<OpenSMTImpl> pimpl;
 };
 
+// Exact value of the float, used for all the constants of the model and of the constraints
+opensmt::FastRational floatToRational(float value);
+
 } // namespace xai::verifiers
 
 #endif //XAI_SMT_OPENSMTVERIFIER_H
@@ -0,0 +1,126 @@
+#include "Explainer.h"
+
+#include <xspace/framework/Config.h>
+#include <xspace/framework/Framework.h>
+#include <xspace/framework/explanation/Explanation.h>
+#include <xspace/framework/explanation/IntervalExplanation.h>
+#include <xspace/framework/explanation/VarBound.h>
+#include <xspace/nn/Dataset.h>
+
+#include <xspace/common/String.h>
+
+#include <nn/NNet.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace xspace::api {
+namespace {
+Framework::Config makeConfig(Options const & options) {
+    Framework::Config config;
+    // The explanations are returned instead
+    config.discardOutput();
+
+    config.setJobs(options.jobs);
+    config.setSpeculativeJobs(options.speculativeJobs);
+    if (options.reverseVarOrdering) { config.reverseVarOrdering(); }
+    // See Options
+    config.usePersistentModel();
+    if (options.boundPropagation) { config.useBoundPropagation(); }
+    if (options.counterexampleCache) { config.useCounterexampleCache(); }
+    if (options.warmStart) { config.useWarmStart(); }
+    config.setCheckTimeout(options.checkTimeout);
+    config.setCheckConflictLimit(options.checkConflictLimit);
+    config.setSampleTimeout(options.sampleTimeout);
+    config.setSampleConflictLimit(options.sampleConflictLimit);
+
+    return config;
+}
+
+std::unique_ptr<xai::nn::NNet> makeNetwork(Model const & model) {
+    return xai::nn::NNet::fromParameters(model.layerSizes, model.weights, model.biases, model.inputLowerBounds,
+                                         model.inputUpperBounds);
+}
+
+Explanation makeExplanation(xspace::Explanation const & explanation) {
+    Explanation result;
+    result.features = explanation.varSize();
+    if (explanation.supportsVolume()) { result.relVolume = explanation.getRelativeVolumeSkipFixed(); }
+
+    std::ostringstream textOss;
+    explanation.print(textOss);
+    result.text = std::move(textOss).str();
+
+    auto const * iexplanationPtr = dynamic_cast<IntervalExplanation const *>(&explanation);
+    if (not iexplanationPtr) { return result; }
+
+    std::size_t const size = iexplanationPtr->size();
+    for (VarIdx idx = 0; idx < size; ++idx) {
+        auto const * optVarBnd = iexplanationPtr->tryGetVarBound(idx);
+        if (not optVarBnd) { continue; }
+        Interval const ival = optVarBnd->toInterval();
+        result.intervals.push_back({.var = idx, .lower = ival.getLower(), .upper = ival.getUpper()});
+    }
+
+    return result;
+}
+} // namespace
+
+struct Explainer::Impl {
+    Impl(Model const & model, Options const & options)
+        : strategiesSpecIss{options.strategies},
+          framework{makeConfig(options), makeNetwork(model), options.verifier, strategiesSpecIss} {}
+
+    std::istringstream strategiesSpecIss;
+    Framework framework;
+};
+
+Explainer::Explainer(Model const & model, Options const & options)
+    : pimpl{std::make_unique<Impl>(model, options)} {}
+
+Explainer::~Explainer() = default;
+Explainer::Explainer(Explainer &&) noexcept = default;
+Explainer & Explainer::operator=(Explainer &&) noexcept = default;
+
+std::size_t Explainer::inputSize() const {
+    return pimpl->framework.varSize();
+}
+
+std::vector<Explanation> Explainer::explain(Samples const & samples) {
+    auto & framework = pimpl->framework;
+    std::size_t const varSize = framework.varSize();
+    if (samples.values.size() % varSize != 0) {
+        throw std::invalid_argument{"The no. values of the samples is not a multiple of the no. inputs: "s +
+                                    std::to_string(samples.values.size())};
+    }
+    std::size_t const size = samples.values.size() / varSize;
+    if (size == 0) { return {}; }
+
+    Dataset::Classifications expectedClassifications;
+    expectedClassifications.reserve(size);
+    if (not samples.expectedClasses.empty()) {
+        if (samples.expectedClasses.size() != size) {
+            throw std::invalid_argument{"Expected a class of each of the "s + std::to_string(size) + " samples"};
+        }
+        for (auto label : samples.expectedClasses) {
+            expectedClassifications.push_back({.label = label});
+        }
+    } else {
+        for (std::size_t i = 0; i < size; ++i) {
+            std::span<Float const> const sample{samples.values.data() + i * varSize, varSize};
+            expectedClassifications.push_back({.label = framework.computeClassificationLabel(sample)});
+        }
+    }
+
+    Dataset dataset{samples.values, varSize, std::move(expectedClassifications), framework.classificationSize()};
+    Explanations explanations = framework.explain(dataset);
+
+    std::vector<Explanation> results;
+    results.reserve(explanations.size());
+    for (auto const & explanationPtr : explanations) {
+        results.push_back(makeExplanation(*explanationPtr));
+    }
+    return results;
+}
+} // namespace xspace::api
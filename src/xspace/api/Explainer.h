@@ -0,0 +1,93 @@
+#ifndef XSPACE_API_EXPLAINER_H
+#define XSPACE_API_EXPLAINER_H
+
+// Public API of the installed library, see `find_package(xspace)` and the target xspace::xspace
+// Only standard types are used here, so that the internals may change without breaking the users
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace xspace::api {
+// Feed-forward network with ReLU activations in the hidden layers
+struct Model {
+    // Including the input and the output layer
+    std::vector<std::size_t> layerSizes{};
+    // Of each layer after the input layer, a row-major matrix with one row per node
+    std::vector<std::vector<float>> weights{};
+    std::vector<std::vector<float>> biases{};
+    // The domains of the inputs
+    std::vector<float> inputLowerBounds{};
+    std::vector<float> inputUpperBounds{};
+};
+
+struct Samples {
+    // One sample after another, each with a value of each input of the model
+    std::vector<float> values{};
+    // If empty, the classification computed by the model is explained
+    std::vector<std::size_t> expectedClasses{};
+};
+
+// The model is always persistent (as with -p): the explanations are converted only after the expansion,
+// when the verifier would have been reset otherwise, while e.g. the explanations of "itp" refer to its terms
+struct Options {
+    // As on the command line, e.g. "abductive" or "ucore interval, min; trial n 2"
+    std::string strategies{"abductive"};
+    // Empty means the default verifier
+    std::string verifier{};
+
+    std::size_t jobs{1};
+    std::size_t speculativeJobs{1};
+
+    bool reverseVarOrdering{};
+    bool boundPropagation{};
+    bool counterexampleCache{};
+    // Requires a single job
+    bool warmStart{};
+
+    // Zero means unlimited; the timeouts are in seconds
+    double checkTimeout{};
+    std::size_t checkConflictLimit{};
+    double sampleTimeout{};
+    std::size_t sampleConflictLimit{};
+};
+
+struct Explanation {
+    struct VarInterval {
+        std::size_t var;
+        // Equal for a fixed variable
+        float lower;
+        float upper;
+    };
+
+    // Of the constrained variables only, in increasing order of the variables; empty if not an interval explanation
+    std::vector<VarInterval> intervals{};
+    // In the same format as printed by the command line tool
+    std::string text{};
+    std::size_t features{};
+    std::optional<double> relVolume{};
+};
+
+// Keeps the model and the verifiers across the calls of `explain`
+// Not thread-safe, the parallelism is controlled by the options
+class Explainer {
+public:
+    explicit Explainer(Model const &, Options const & = {});
+    ~Explainer();
+    Explainer(Explainer &&) noexcept;
+    Explainer & operator=(Explainer &&) noexcept;
+
+    std::size_t inputSize() const;
+
+    // Throws std::invalid_argument on inconsistent inputs
+    std::vector<Explanation> explain(Samples const &);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl;
+};
+} // namespace xspace::api
+
+#endif // XSPACE_API_EXPLAINER_H
@@ -0,0 +1,13 @@
+#ifndef XSPACE_BENCH_H
+#define XSPACE_BENCH_H
+
+#include <string>
+
+namespace xspace::bench {
+inline std::string const dataDir = XSPACE_DATA_DIR "/";
+
+// The macrobenchmarks of each strategy on each bundled model, registered at runtime from the tables of the pairs
+void registerStrategyBenchmarks();
+} // namespace xspace::bench
+
+#endif // XSPACE_BENCH_H
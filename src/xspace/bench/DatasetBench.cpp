@@ -0,0 +1,46 @@
+#include "Bench.h"
+
+#include <xspace/nn/Dataset.h>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+
+namespace {
+using xspace::bench::dataDir;
+
+// Arguments: no. parsing threads
+void loadDataset(benchmark::State & state, std::string_view datasetFn) {
+    std::size_t const nThreads = state.range(0);
+    std::string const datasetPath = dataDir + std::string{datasetFn};
+
+    std::size_t size{};
+    for (auto _ : state) {
+        xspace::Dataset dataset{datasetPath, nThreads};
+        size = dataset.size();
+        benchmark::DoNotOptimize(dataset);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+} // namespace
+
+BENCHMARK_CAPTURE(loadDataset, heart_attack_full, "datasets/heart_attack/heart_attack_full.csv")
+    ->ArgName("jobs")
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(loadDataset, obesity_full, "datasets/obesity/obesity_full.csv")
+    ->ArgName("jobs")
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(loadDataset, mnist_short, "datasets/mnist/mnist_short.csv")
+    ->ArgName("jobs")
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,111 @@
+#include "Bench.h"
+
+#include <xspace/framework/Config.h>
+#include <xspace/framework/Framework.h>
+#include <xspace/nn/Dataset.h>
+
+#include <nn/NNet.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace {
+using namespace std::literals;
+using xspace::bench::dataDir;
+
+// Arguments: whether to use the persistent model, max. no. samples
+void expand(benchmark::State & state, std::string_view modelFn, std::string_view datasetFn,
+            std::string_view strategiesSpec) {
+    bool const persistentModel = state.range(0);
+    auto const maxSamples = state.range(1);
+
+    xspace::Framework::Config config;
+    // The printing of the explanations is not of interest here
+    config.discardOutput();
+    if (persistentModel) { config.usePersistentModel(); }
+    config.setMaxSamples(maxSamples);
+
+    std::string const modelPath = dataDir + std::string{modelFn};
+    xspace::Dataset dataset{dataDir + std::string{datasetFn}};
+    std::size_t const size = std::min<std::size_t>(maxSamples, dataset.size());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::istringstream strategiesSpecIss{std::string{strategiesSpec}};
+        xspace::Framework framework{config, xai::nn::NNet::fromFile(modelPath), ""sv, strategiesSpecIss};
+        state.ResumeTiming();
+
+        auto explanations = framework.explain(dataset);
+        benchmark::DoNotOptimize(explanations);
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+struct StrategyBenchmark {
+    std::string_view name;
+    std::string_view strategiesSpec;
+};
+
+struct ModelBenchmark {
+    std::string_view name;
+    std::string_view modelFn;
+    std::string_view datasetFn;
+    std::size_t maxSamples;
+};
+
+// A portfolio is the best of its chains, hence its chains are also included individually
+constexpr StrategyBenchmark strategyBenchmarks[] = {
+    {"abductive", "abductive"},
+    {"abductive_dc", "abductive dc"},
+    {"trial", "trial n 4"},
+    {"trial_bisect", "trial bisect"},
+    {"ucore", "ucore"},
+    {"ucore_interval", "ucore interval"},
+    {"itp", "itp"},
+    {"portfolio", "portfolio [abductive] [ucore interval], first"},
+};
+
+// The larger models explain fewer samples so that each benchmark finishes within minutes
+constexpr ModelBenchmark modelBenchmarks[] = {
+    {"toy", "models/toy.nnet", "datasets/toy.csv", 4},
+    {"heart_attack", "models/heart_attack/heart_attack-50.nnet", "datasets/heart_attack/heart_attack_quick.csv", 10},
+    {"obesity", "models/obesity/obesity-10-20-10.nnet", "datasets/obesity/obesity_quick.csv", 10},
+    {"mnist200", "models/mnist/mnist-200.nnet", "datasets/mnist/mnist_quick.csv", 1},
+};
+} // namespace
+
+namespace xspace::bench {
+void registerStrategyBenchmarks() {
+    for (auto const & model : modelBenchmarks) {
+        for (auto const & strategy : strategyBenchmarks) {
+            std::string const name = "strategy/"s + std::string{model.name} + '/' + std::string{strategy.name};
+            benchmark::RegisterBenchmark(name.c_str(), expand, model.modelFn, model.datasetFn, strategy.strategiesSpec)
+                ->ArgNames({"persistent", "samples"})
+                ->Args({1, static_cast<std::int64_t>(model.maxSamples)})
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+}
+} // namespace xspace::bench
+
+// The persistent model pays off when the checks are cheap compared to the encoding of the model,
+// which is the case of larger models with easy samples (e.g. 'ucore') rather than of many checks (e.g. 'abductive')
+BENCHMARK_CAPTURE(expand, toy_abductive, "models/toy.nnet", "datasets/toy.csv", "abductive")
+    ->ArgNames({"persistent", "samples"})
+    ->ArgsProduct({{0, 1}, {1, 10}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(expand, mnist200_ucore, "models/mnist/mnist-200.nnet", "datasets/mnist/mnist_short.csv", "ucore")
+    ->ArgNames({"persistent", "samples"})
+    ->ArgsProduct({{0, 1}, {1, 10}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(expand, mnist200_abductive, "models/mnist/mnist-200.nnet", "datasets/mnist/mnist_short.csv",
+                  "abductive")
+    ->ArgNames({"persistent", "samples"})
+    ->ArgsProduct({{0, 1}, {1}})
+    ->Unit(benchmark::kMillisecond);
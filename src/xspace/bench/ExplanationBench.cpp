@@ -0,0 +1,169 @@
+#include "Bench.h"
+
+#include <xspace/framework/Config.h>
+#include <xspace/framework/Framework.h>
+#include <xspace/framework/explanation/IntervalExplanation.h>
+#include <xspace/framework/explanation/VarBound.h>
+#include <xspace/nn/Dataset.h>
+
+#include <nn/NNet.h>
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+using xspace::bench::dataDir;
+
+using xspace::IntervalExplanation;
+using PrintFormat = IntervalExplanation::PrintFormat;
+
+// Point, interval and free variables in turn, which resembles the explanations of the strategies
+IntervalExplanation makeExplanation(xspace::Framework const & framework, xspace::Dataset::Sample const & sample) {
+    IntervalExplanation iexplanation{framework};
+    std::size_t const varSize = framework.varSize();
+    for (xspace::VarIdx idx = 0; idx < varSize; ++idx) {
+        xspace::Float const val = sample[idx];
+        switch (idx % 3) {
+            case 0:
+                iexplanation.insertVarBound(xspace::VarBound{framework, idx, val});
+                break;
+            case 1: {
+                auto const & domain = framework.getDomainInterval(idx);
+                xspace::Float const lower = (domain.getLower() + val) / 2;
+                xspace::Float const upper = (val + domain.getUpper()) / 2;
+                if (lower < upper) {
+                    iexplanation.insertVarBound(xspace::VarBound{framework, idx, xspace::Interval{lower, upper}});
+                } else {
+                    iexplanation.insertVarBound(xspace::VarBound{framework, idx, val});
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return iexplanation;
+}
+
+std::vector<IntervalExplanation> makeExplanations(xspace::Framework const & framework,
+                                                  xspace::Dataset const & dataset) {
+    std::vector<IntervalExplanation> explanations;
+    explanations.reserve(dataset.size());
+    for (auto const & sample : dataset.getSamples()) {
+        explanations.push_back(makeExplanation(framework, sample));
+    }
+    return explanations;
+}
+
+void printExplanation(std::ostream & os, IntervalExplanation const & iexplanation, PrintFormat format) {
+    using enum PrintFormat;
+    switch (format) {
+        case smtlib2:
+            iexplanation.printSmtLib2(os);
+            os << '\n';
+            return;
+        case bounds:
+            iexplanation.printBounds(os);
+            os << '\n';
+            return;
+        case intervals:
+            iexplanation.printIntervals(os);
+            os << '\n';
+            return;
+        case binary:
+            // The binary records are not delimited
+            iexplanation.printBinary(os);
+            return;
+    }
+}
+
+void constructExplanations(benchmark::State & state, std::string_view modelFn, std::string_view datasetFn) {
+    xspace::Framework framework{xspace::Framework::Config{}, xai::nn::NNet::fromFile(dataDir + std::string{modelFn})};
+    xspace::Dataset dataset{dataDir + std::string{datasetFn}};
+
+    for (auto _ : state) {
+        auto explanations = makeExplanations(framework, dataset);
+        benchmark::DoNotOptimize(explanations);
+    }
+
+    state.SetItemsProcessed(state.iterations() * dataset.size());
+}
+
+void printExplanations(benchmark::State & state, std::string_view modelFn, std::string_view datasetFn,
+                       PrintFormat format) {
+    xspace::Framework framework{xspace::Framework::Config{}, xai::nn::NNet::fromFile(dataDir + std::string{modelFn})};
+    xspace::Dataset dataset{dataDir + std::string{datasetFn}};
+    auto const explanations = makeExplanations(framework, dataset);
+
+    std::size_t bytes{};
+    for (auto _ : state) {
+        std::ostringstream oss;
+        if (format == PrintFormat::binary) { IntervalExplanation::printBinaryHeader(oss, framework.varSize()); }
+        for (auto const & iexplanation : explanations) {
+            printExplanation(oss, iexplanation, format);
+        }
+        bytes = oss.view().size();
+        benchmark::DoNotOptimize(oss);
+    }
+
+    state.SetItemsProcessed(state.iterations() * explanations.size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// The computation of the outputs of the dataset, which the parsing requires, is included
+void parseExplanations(benchmark::State & state, std::string_view modelFn, std::string_view datasetFn,
+                       PrintFormat format) {
+    xspace::Framework framework{xspace::Framework::Config{}, xai::nn::NNet::fromFile(dataDir + std::string{modelFn})};
+    xspace::Dataset dataset{dataDir + std::string{datasetFn}};
+
+    auto const explanationsPath = std::filesystem::temp_directory_path() / "xspace-bench-explanations.phi";
+    {
+        std::ofstream ofs{explanationsPath, std::ios::binary};
+        if (format == PrintFormat::binary) { IntervalExplanation::printBinaryHeader(ofs, framework.varSize()); }
+        for (auto const & iexplanation : makeExplanations(framework, dataset)) {
+            printExplanation(ofs, iexplanation, format);
+        }
+    }
+
+    for (auto _ : state) {
+        auto explanations = framework.parse(explanationsPath.string(), dataset);
+        benchmark::DoNotOptimize(explanations);
+    }
+
+    state.SetItemsProcessed(state.iterations() * dataset.size());
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(explanationsPath));
+}
+} // namespace
+
+BENCHMARK_CAPTURE(constructExplanations, obesity_full, "models/obesity/obesity-10-20-10.nnet",
+                  "datasets/obesity/obesity_full.csv")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(constructExplanations, mnist_short, "models/mnist/mnist-200.nnet", "datasets/mnist/mnist_short.csv")
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(printExplanations, mnist_short_smtlib2, "models/mnist/mnist-200.nnet",
+                  "datasets/mnist/mnist_short.csv", PrintFormat::smtlib2)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(printExplanations, mnist_short_bounds, "models/mnist/mnist-200.nnet",
+                  "datasets/mnist/mnist_short.csv", PrintFormat::bounds)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(printExplanations, mnist_short_intervals, "models/mnist/mnist-200.nnet",
+                  "datasets/mnist/mnist_short.csv", PrintFormat::intervals)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(printExplanations, mnist_short_binary, "models/mnist/mnist-200.nnet",
+                  "datasets/mnist/mnist_short.csv", PrintFormat::binary)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(parseExplanations, mnist_short_smtlib2, "models/mnist/mnist-200.nnet",
+                  "datasets/mnist/mnist_short.csv", PrintFormat::smtlib2)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(parseExplanations, mnist_short_binary, "models/mnist/mnist-200.nnet",
+                  "datasets/mnist/mnist_short.csv", PrintFormat::binary)
+    ->Unit(benchmark::kMicrosecond);
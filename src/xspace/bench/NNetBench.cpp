@@ -0,0 +1,92 @@
+#include "Bench.h"
+
+#include <nn/NNet.h>
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+using xspace::bench::dataDir;
+
+xai::nn::NNet::input_t makeMidpointInput(xai::nn::NNet const & network) {
+    xai::nn::NNet::input_t input(network.getInputSize());
+    for (std::size_t node = 0; node < input.size(); ++node) {
+        input[node] = (network.getInputLowerBound(node) + network.getInputUpperBound(node)) / 2;
+    }
+    return input;
+}
+
+void computeOutput(benchmark::State & state, std::string_view modelFn) {
+    auto networkPtr = xai::nn::NNet::fromFile(dataDir + std::string{modelFn});
+    auto const & network = *networkPtr;
+
+    auto const input = makeMidpointInput(network);
+
+    for (auto _ : state) {
+        auto output = xai::nn::computeOutput(input, network);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void loadModel(benchmark::State & state, std::string_view modelFn, bool binary) {
+    std::string modelPath = dataDir + std::string{modelFn};
+    if (binary) {
+        auto const binaryPath = std::filesystem::temp_directory_path() / "xspace-bench-model.xnn";
+        xai::nn::NNet::fromFile(modelPath)->writeBinaryFile(binaryPath.string());
+        modelPath = binaryPath.string();
+    }
+
+    for (auto _ : state) {
+        auto networkPtr = xai::nn::NNet::fromFile(modelPath);
+        benchmark::DoNotOptimize(networkPtr);
+    }
+}
+
+// Arguments: batch size, no. threads
+void computeOutputs(benchmark::State & state, std::string_view modelFn) {
+    std::size_t const batchSize = state.range(0);
+    std::size_t const nThreads = state.range(1);
+
+    auto networkPtr = xai::nn::NNet::fromFile(dataDir + std::string{modelFn});
+    auto const & network = *networkPtr;
+
+    auto const input = makeMidpointInput(network);
+    std::vector<float> inputs;
+    inputs.reserve(batchSize * input.size());
+    for (std::size_t i = 0; i < batchSize; ++i) {
+        inputs.insert(inputs.end(), input.begin(), input.end());
+    }
+
+    for (auto _ : state) {
+        auto outputs = xai::nn::computeOutputs(inputs, batchSize, network, nThreads);
+        benchmark::DoNotOptimize(outputs);
+    }
+
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+} // namespace
+
+BENCHMARK_CAPTURE(loadModel, toy_text, "models/toy.nnet", false)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(loadModel, heart_attack50_text, "models/heart_attack/heart_attack-50.nnet", false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(loadModel, obesity_text, "models/obesity/obesity-10-20-10.nnet", false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(loadModel, mnist200_text, "models/mnist/mnist-200.nnet", false)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(loadModel, mnist200_binary, "models/mnist/mnist-200.nnet", true)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(computeOutput, toy, "models/toy.nnet")->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(computeOutput, heart_attack50, "models/heart_attack/heart_attack-50.nnet")
+    ->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(computeOutput, obesity, "models/obesity/obesity-10-20-10.nnet")->Unit(benchmark::kNanosecond);
+BENCHMARK_CAPTURE(computeOutput, mnist200, "models/mnist/mnist-200.nnet")->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(computeOutputs, mnist200, "models/mnist/mnist-200.nnet")
+    ->ArgNames({"batch", "threads"})
+    ->ArgsProduct({{1000, 10000}, {1, 4}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
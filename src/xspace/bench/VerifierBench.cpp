@@ -0,0 +1,65 @@
+#include "Bench.h"
+
+#include <nn/NNet.h>
+#include <verifiers/opensmt/OpenSMTVerifier.h>
+
+#include <common/numbers/FastRational.h>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+using xspace::bench::dataDir;
+
+// All the parameters of the model, as they are converted when the model is loaded
+void floatToRational(benchmark::State & state, std::string_view modelFn) {
+    auto networkPtr = xai::nn::NNet::fromFile(dataDir + std::string{modelFn});
+    auto const & network = *networkPtr;
+
+    std::vector<float> values;
+    for (std::size_t layer = 1; layer < network.getNumLayers(); ++layer) {
+        for (std::size_t node = 0; node < network.getLayerSize(layer); ++node) {
+            auto const weights = network.getWeights(layer, node);
+            values.insert(values.end(), weights.begin(), weights.end());
+            values.push_back(network.getBias(layer, node));
+        }
+    }
+
+    for (auto _ : state) {
+        for (float value : values) {
+            auto rational = xai::verifiers::floatToRational(value);
+            benchmark::DoNotOptimize(rational);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void loadModelOpenSMT(benchmark::State & state, std::string_view modelFn) {
+    auto networkPtr = xai::nn::NNet::fromFile(dataDir + std::string{modelFn});
+
+    xai::verifiers::OpenSMTVerifier verifier;
+    verifier.init();
+
+    for (auto _ : state) {
+        verifier.loadModel(*networkPtr);
+
+        state.PauseTiming();
+        verifier.reset();
+        state.ResumeTiming();
+    }
+}
+} // namespace
+
+BENCHMARK_CAPTURE(floatToRational, heart_attack50, "models/heart_attack/heart_attack-50.nnet")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(floatToRational, mnist200, "models/mnist/mnist-200.nnet")->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(loadModelOpenSMT, toy, "models/toy.nnet")->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(loadModelOpenSMT, heart_attack50, "models/heart_attack/heart_attack-50.nnet")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(loadModelOpenSMT, obesity, "models/obesity/obesity-10-20-10.nnet")->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(loadModelOpenSMT, mnist200, "models/mnist/mnist-200.nnet")->Unit(benchmark::kMillisecond);
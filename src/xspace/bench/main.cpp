@@ -0,0 +1,25 @@
+#include "Bench.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+// The results are printed in JSON by default so that the runs can be compared to track regressions,
+// e.g. by 'compare.py' of Google Benchmark; any '--benchmark_format' on the command line takes precedence
+int main(int argc, char ** argv) {
+    static char jsonFormatArg[] = "--benchmark_format=json";
+
+    std::vector<char *> args(argv, argv + argc);
+    args.insert(args.begin() + 1, jsonFormatArg);
+    int argsSize = args.size();
+    args.push_back(nullptr);
+
+    benchmark::Initialize(&argsSize, args.data());
+    if (benchmark::ReportUnrecognizedArguments(argsSize, args.data())) { return 1; }
+
+    xspace::bench::registerStrategyBenchmarks();
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
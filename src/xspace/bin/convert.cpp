@@ -0,0 +1,55 @@
+#include <nn/NNet.h>
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+void printUsage(char * const argv[], std::ostream & os = std::cout) {
+    assert(argv);
+    std::string const cmd = argv[0];
+
+    os << "USAGE: " << cmd << " <nn_model_fn> <output_fn>\n";
+    os << "Converts the model to the binary format that is loaded without parsing\n";
+    os << "The input model can be in the .nnet format or already in the binary format\n";
+
+    os << "\nEXAMPLES:\n";
+    os << cmd << " data/models/mnist/mnist-200.nnet mnist-200.xnn\n";
+
+    os.flush();
+}
+} // namespace
+
+int main(int argc, char * argv[]) try {
+    constexpr int nExpectedArgs = 2;
+
+    int const nArgs = argc - 1;
+    assert(nArgs >= 0);
+    if (nArgs == 0) {
+        printUsage(argv);
+        return 0;
+    }
+
+    if (nArgs != nExpectedArgs) {
+        std::cerr << "Expected " << nExpectedArgs << " arguments, got: " << nArgs << '\n';
+        printUsage(argv, std::cerr);
+        return 1;
+    }
+
+    std::string_view const nnModelFn = argv[1];
+    std::string_view const outputFn = argv[2];
+
+    auto networkPtr = xai::nn::NNet::fromFile(nnModelFn);
+    assert(networkPtr);
+    networkPtr->writeBinaryFile(outputFn);
+
+    return 0;
+} catch (std::system_error const & e) {
+    std::cerr << "Terminated with a system error:\n" << e.what() << '\n' << std::endl;
+    return e.code().value();
+} catch (std::exception const & e) {
+    std::cerr << "Terminated with an exception:\n" << e.what() << '\n' << std::endl;
+    return 2;
+}
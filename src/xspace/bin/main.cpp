@@ -3,6 +3,7 @@
 #include <xspace/framework/expand/strategy/Strategies.h>
 #include <xspace/framework/explanation/Explanation.h>
 #include <xspace/nn/Dataset.h>
+#include <xspace/server/Server.h>
 
 #include <iomanip>
 #include <iostream>
@@ -48,22 +49,26 @@ void printUsage(char * const argv[], std::ostream & os = std::cout) {
 
     os << "USAGE: " << cmd;
     os << " <nn_model_fn> <dataset_fn> <exp_strategies_spec> [<options>]\n";
+    os << "       " << cmd << " serve <nn_model_fn> <exp_strategies_spec> --socket <path> [<options>]\n";
 
     os << "STRATEGIES SPEC: '<spec1>[; <spec2>]...'\n";
     os << "Each spec: '<name>[ <param>[, <param>]...]'\n";
     os << "Strategies and parameters:\n";
     //+ template by the strategy and move the params to the classes as well
-    printUsageStrategyRow(os, Framework::Expand::AbductiveStrategy::name());
-    printUsageStrategyRow(os, Framework::Expand::TrialAndErrorStrategy::name(), {"n <int>"});
+    printUsageStrategyRow(os, Framework::Expand::AbductiveStrategy::name(), {"dc"});
+    printUsageStrategyRow(os, Framework::Expand::TrialAndErrorStrategy::name(), {"n <int>", "bisect [<eps>]"});
     printUsageStrategyRow(os, UnsatCoreStrategy::name(), {"sample", "interval", "min"});
     printUsageStrategyRow(os, InterpolationStrategy::name(),
                           {"weak", "strong", "weaker", "stronger", "bweak", "bstrong", "aweak", "astrong", "aweaker",
                            "astronger", "afactor <factor>", "vars x<i>..."});
+    printUsageStrategyRow(os, Framework::Expand::PortfolioStrategy::name(),
+                          {"[<spec>[ + <spec>]...[ @ <verifier>]]...", "first", "best [<deadline>]"});
 
     os << "VERIFIERS: opensmt";
 #ifdef MARABOU
     os << " marabou";
 #endif
+    os << " deeppoly[+<verifier>]";
     os << '\n';
 
     os << "OPTIONS:\n";
@@ -76,12 +81,23 @@ void printUsage(char * const argv[], std::ostream & os = std::cout) {
     printUsageOptRow(os, 'i', "", "Print the resulting explanations in the form of intervals");
     printUsageOptRow(os, 'n', "<int>", "Maximum no. samples to be processed");
     printUsageOptRow(os, 'S', "", "Shuffle samples");
+    printUsageOptRow(os, 'j', "<int>", "Number of parallel jobs, each with its own verifier");
+    printUsageOptRow(os, 'k', "<int>", "Number of speculative checks within a sample run in parallel");
+    printUsageOptRow(os, 'p', "", "Encode the model only once and reuse it across samples");
+    printUsageOptRow(os, 'b', "", "Skip the checks that interval bound propagation already proves");
+    printUsageOptRow(os, 'c', "", "Skip the checks that a counterexample found earlier already refutes");
+    printUsageOptRow(os, 'w', "", "Start from the explanation of the nearest explained sample of the same class");
+    printUsageOptRow(os, 'C', "<dir>", "Reuse the explanations cached in the directory and store the new ones");
 
     os << "\nEXAMPLES:\n";
     os << cmd << " data/models/toy.nnet data/datasets/toy.csv abductive\n";
     os << cmd << " data/models/toy.nnet data/datasets/toy.csv 'ucore interval, min' -rvs\n";
     os << cmd << " data/models/toy.nnet data/datasets/toy.csv 'itp aweaker, bstrong; ucore'\n";
     os << cmd << " data/models/toy.nnet data/datasets/toy.csv 'trial n 2' -n1\n";
+    os << cmd << " data/models/toy.nnet data/datasets/toy.csv 'abductive; trial bisect 0.001' -n1\n";
+    os << cmd << " data/models/toy.nnet data/datasets/toy.csv abductive -j4\n";
+    os << cmd << " data/models/mnist/mnist-200.nnet data/datasets/mnist/mnist_short.csv 'abductive dc' -b\n";
+    os << cmd << " data/models/mnist/mnist-200.nnet data/datasets/mnist/mnist_short.csv abductive -n1 -k8\n";
 
     os.flush();
 }
@@ -103,17 +119,22 @@ int main(int argc, char * argv[]) try {
         return 1;
     }
 
+    // The server receives the samples in the requests instead of the dataset
+    bool const serving = (std::string_view{argv[1]} == "serve");
+
     int i = 0;
+    if (serving) { ++i; }
     std::string_view const nnModelFn = argv[++i];
     auto networkPtr = xai::nn::NNet::fromFile(nnModelFn);
     assert(networkPtr);
 
-    std::string_view const datasetFn = argv[++i];
+    std::string_view const datasetFn = serving ? std::string_view{} : argv[++i];
 
     std::string_view const strategiesSpec = argv[++i];
 
     std::string verifierName;
     std::string explanationsFn;
+    std::string socketPath;
 
     xspace::Framework::Config config;
 
@@ -121,6 +142,15 @@ int main(int argc, char * argv[]) try {
     // constexpr int versionLongOpt = 1;
     constexpr int formatLongOpt = 2;
     constexpr int filterLongOpt = 3;
+    constexpr int checkpointLongOpt = 4;
+    constexpr int resumeLongOpt = 5;
+    constexpr int flushLongOpt = 6;
+    constexpr int traceLongOpt = 7;
+    constexpr int checkTimeoutLongOpt = 8;
+    constexpr int checkConflictsLongOpt = 9;
+    constexpr int sampleTimeoutLongOpt = 10;
+    constexpr int sampleConflictsLongOpt = 11;
+    constexpr int socketLongOpt = 12;
 
     //+ not documented
     struct ::option longOptions[] = {{"help", no_argument, nullptr, 'h'},
@@ -133,22 +163,73 @@ int main(int argc, char * argv[]) try {
                                      {"shuffle-samples", no_argument, nullptr, 'S'},
                                      {"max-samples", required_argument, nullptr, 'n'},
                                      {"filter-samples", required_argument, &selectedLongOpt, filterLongOpt},
+                                     {"jobs", required_argument, nullptr, 'j'},
+                                     {"speculative-jobs", required_argument, nullptr, 'k'},
+                                     {"persistent-model", no_argument, nullptr, 'p'},
+                                     {"bound-propagation", no_argument, nullptr, 'b'},
+                                     {"counterexample-cache", no_argument, nullptr, 'c'},
+                                     {"warm-start", no_argument, nullptr, 'w'},
+                                     {"cache", required_argument, nullptr, 'C'},
+                                     {"checkpoint", required_argument, &selectedLongOpt, checkpointLongOpt},
+                                     {"resume", no_argument, &selectedLongOpt, resumeLongOpt},
+                                     {"flush", required_argument, &selectedLongOpt, flushLongOpt},
+                                     {"trace", required_argument, &selectedLongOpt, traceLongOpt},
+                                     {"check-timeout", required_argument, &selectedLongOpt, checkTimeoutLongOpt},
+                                     {"check-conflicts", required_argument, &selectedLongOpt, checkConflictsLongOpt},
+                                     {"sample-timeout", required_argument, &selectedLongOpt, sampleTimeoutLongOpt},
+                                     {"sample-conflicts", required_argument, &selectedLongOpt, sampleConflictsLongOpt},
+                                     {"socket", required_argument, &selectedLongOpt, socketLongOpt},
                                      {0, 0, 0, 0}};
 
     while (true) {
         int optIndex = 0;
-        int c = getopt_long(argc, argv, ":hV:E:vrsiSn:", longOptions, &optIndex);
+        int c = getopt_long(argc, argv, ":hV:E:vrsiSn:j:k:pbcwC:", longOptions, &optIndex);
         if (c == -1) { break; }
 
         switch (c) {
             case 0: {
-                std::string_view optargStr{optarg};
+                std::string_view optargStr = optarg ? optarg : "";
                 switch (selectedLongOpt) {
+                    case checkpointLongOpt:
+                        config.useCheckpoint(std::string{optargStr});
+                        break;
+                    case resumeLongOpt:
+                        config.resumeFromCheckpoint();
+                        break;
+                    case flushLongOpt:
+                        if (optargStr == "sample") {
+                            config.setOutputFlushPeriod(1);
+                        } else if (optargStr == "exit") {
+                            config.flushOutputAtExit();
+                        } else {
+                            config.setOutputFlushPeriod(std::stoul(std::string{optargStr}));
+                        }
+                        break;
+                    case traceLongOpt:
+                        config.useTrace(std::string{optargStr});
+                        break;
+                    case checkTimeoutLongOpt:
+                        config.setCheckTimeout(std::stod(std::string{optargStr}));
+                        break;
+                    case checkConflictsLongOpt:
+                        config.setCheckConflictLimit(std::stoul(std::string{optargStr}));
+                        break;
+                    case sampleTimeoutLongOpt:
+                        config.setSampleTimeout(std::stod(std::string{optargStr}));
+                        break;
+                    case sampleConflictsLongOpt:
+                        config.setSampleConflictLimit(std::stoul(std::string{optargStr}));
+                        break;
+                    case socketLongOpt:
+                        socketPath = optargStr;
+                        break;
                     case formatLongOpt:
                         if (optargStr == "smtlib2") {
                             config.printIntervalExplanationsInSmtLib2Format();
                         } else if (optargStr == "intervals") {
                             config.printIntervalExplanationsInIntervalFormat();
+                        } else if (optargStr == "binary") {
+                            config.printIntervalExplanationsInBinaryFormat();
                         } else {
                             assert(optargStr == "bounds");
                             config.printingIntervalExplanationsInBoundFormat();
@@ -215,6 +296,31 @@ int main(int argc, char * argv[]) try {
                 config.setMaxSamples(n);
                 break;
             }
+            case 'j': {
+                auto const n = std::stoull(optarg);
+                config.setJobs(n);
+                break;
+            }
+            case 'k': {
+                auto const n = std::stoull(optarg);
+                config.setSpeculativeJobs(n);
+                break;
+            }
+            case 'p':
+                config.usePersistentModel();
+                break;
+            case 'b':
+                config.useBoundPropagation();
+                break;
+            case 'c':
+                config.useCounterexampleCache();
+                break;
+            case 'w':
+                config.useWarmStart();
+                break;
+            case 'C':
+                config.useExplanationCache(optarg);
+                break;
             default:
                 assert(c == '?');
                 std::cerr << "Unrecognized option: '-" << char(optopt) << "'\n\n";
@@ -223,6 +329,13 @@ int main(int argc, char * argv[]) try {
         }
     }
 
+    if (serving) {
+        if (socketPath.empty()) { throw std::invalid_argument{"The server requires the option --socket <path>"}; }
+        xspace::Server server{config, std::move(networkPtr), verifierName, std::string{strategiesSpec}};
+        server.serve(socketPath);
+        return 0;
+    }
+
     auto dataset = xspace::Dataset{datasetFn};
     std::size_t const size = dataset.size();
 
@@ -0,0 +1,125 @@
+#include "KdTree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <numeric>
+
+namespace xspace {
+KdTree::KdTree(std::span<Float const> pts, std::size_t dimension) : points{pts}, dim{dimension} {
+    assert(dim > 0);
+    assert(points.size() % dim == 0);
+    std::size_t const size = points.size() / dim;
+    indices.resize(size);
+    std::iota(indices.begin(), indices.end(), Idx{0});
+
+    leaves.resize(size);
+    active.resize(size);
+
+    if (size == 0) { return; }
+    nodes.reserve(2 * (size / leafSize + 1));
+    build(0, size, 0);
+}
+
+std::size_t KdTree::build(std::size_t begin, std::size_t end, std::size_t parent) {
+    std::size_t const nodeIdx = nodes.size();
+    nodes.push_back({.begin = begin, .end = end, .parent = parent});
+    auto const makeLeaf = [&] {
+        for (std::size_t i = begin; i < end; ++i) {
+            leaves[indices[i]] = nodeIdx;
+        }
+        return nodeIdx;
+    };
+    if (end - begin <= leafSize) { return makeLeaf(); }
+
+    // Split along the dimension with the largest spread
+    std::size_t splitDim = 0;
+    Float maxSpread = -1;
+    for (std::size_t d = 0; d < dim; ++d) {
+        auto const [minIt, maxIt] = std::minmax_element(
+            indices.begin() + begin, indices.begin() + end,
+            [&](Idx i, Idx j) { return points[i * dim + d] < points[j * dim + d]; });
+        Float const spread = points[*maxIt * dim + d] - points[*minIt * dim + d];
+        if (spread > maxSpread) {
+            maxSpread = spread;
+            splitDim = d;
+        }
+    }
+    // All the points are the same
+    if (maxSpread == 0) { return makeLeaf(); }
+
+    std::size_t const mid = begin + (end - begin) / 2;
+    std::nth_element(indices.begin() + begin, indices.begin() + mid, indices.begin() + end,
+                     [&](Idx i, Idx j) { return points[i * dim + splitDim] < points[j * dim + splitDim]; });
+    Float const splitVal = points[indices[mid] * dim + splitDim];
+
+    std::size_t const left = build(begin, mid, nodeIdx);
+    std::size_t const right = build(mid, end, nodeIdx);
+    auto & node = nodes[nodeIdx];
+    node.splitDim = splitDim;
+    node.splitVal = splitVal;
+    node.left = left;
+    node.right = right;
+    return nodeIdx;
+}
+
+void KdTree::activate(Idx idx) {
+    if (active[idx]) { return; }
+    active[idx] = true;
+
+    std::size_t nodeIdx = leaves[idx];
+    while (true) {
+        auto & node = nodes[nodeIdx];
+        ++node.activeCount;
+        if (nodeIdx == 0) { break; }
+        nodeIdx = node.parent;
+    }
+}
+
+std::optional<KdTree::Idx> KdTree::findNearest(std::span<Float const> point, Filter const & filter) const {
+    return findNearest(point, filter, false);
+}
+
+std::optional<KdTree::Idx> KdTree::findNearestActive(std::span<Float const> point, Filter const & filter) const {
+    return findNearest(point, filter, true);
+}
+
+std::optional<KdTree::Idx> KdTree::findNearest(std::span<Float const> point, Filter const & filter,
+                                               bool activeOnly) const {
+    assert(point.size() == dim);
+    if (nodes.empty()) { return std::nullopt; }
+
+    Nearest nearest{.distance2 = std::numeric_limits<Float>::infinity()};
+    findNearest(0, point, filter, activeOnly, nearest);
+    return nearest.optIdx;
+}
+
+void KdTree::findNearest(std::size_t nodeIdx, std::span<Float const> point, Filter const & filter, bool activeOnly,
+                         Nearest & nearest) const {
+    auto const & node = nodes[nodeIdx];
+    if (activeOnly and node.activeCount == 0) { return; }
+
+    if (node.isLeaf()) {
+        for (std::size_t i = node.begin; i < node.end; ++i) {
+            Idx const idx = indices[i];
+            if (activeOnly and not active[idx]) { continue; }
+            if (filter and not filter(idx)) { continue; }
+            auto const other = getPoint(idx);
+            Float distance2 = 0;
+            for (std::size_t d = 0; d < dim; ++d) {
+                Float const diff = point[d] - other[d];
+                distance2 += diff * diff;
+            }
+            if (distance2 < nearest.distance2) { nearest = {.optIdx = idx, .distance2 = distance2}; }
+        }
+        return;
+    }
+
+    // The left subtree contains the values lower or equal to the split value and the right one greater or equal
+    Float const diff = point[node.splitDim] - node.splitVal;
+    std::size_t const nearChild = (diff < 0) ? node.left : node.right;
+    std::size_t const farChild = (diff < 0) ? node.right : node.left;
+    findNearest(nearChild, point, filter, activeOnly, nearest);
+    if (diff * diff < nearest.distance2) { findNearest(farChild, point, filter, activeOnly, nearest); }
+}
+} // namespace xspace
@@ -0,0 +1,81 @@
+#ifndef XSPACE_KDTREE_H
+#define XSPACE_KDTREE_H
+
+#include "Core.h"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace xspace {
+// Nearest neighbor search w.r.t. the Euclidean distance over a static set of points
+// The points are stored row by row and are not copied, hence they must outlive the tree
+// The searches can be restricted to the points activated so far, which skips the subtrees without any of them
+class KdTree {
+public:
+    using Idx = std::size_t;
+    using Filter = std::function<bool(Idx)>;
+
+    static constexpr std::size_t leafSize = 8;
+
+    KdTree(std::span<Float const> points, std::size_t dimension);
+
+    std::size_t size() const { return indices.size(); }
+    std::size_t dimension() const { return dim; }
+
+    // Only the points that pass the filter are considered
+    std::optional<Idx> findNearest(std::span<Float const> point, Filter const & = {}) const;
+    // Moreover only the active points are considered
+    std::optional<Idx> findNearestActive(std::span<Float const> point, Filter const & = {}) const;
+
+    bool isActive(Idx idx) const { return active[idx]; }
+    void activate(Idx);
+
+protected:
+    struct Node {
+        // Of the indices, leaves only
+        std::size_t begin;
+        std::size_t end;
+
+        std::size_t splitDim{};
+        Float splitVal{};
+        // Zero in leaves, the root cannot be a child
+        std::size_t left{};
+        std::size_t right{};
+        // The root is its own parent
+        std::size_t parent{};
+
+        // Of the whole subtree
+        std::size_t activeCount{};
+
+        bool isLeaf() const { return left == 0; }
+    };
+
+    struct Nearest {
+        std::optional<Idx> optIdx{};
+        Float distance2;
+    };
+
+    std::span<Float const> getPoint(Idx idx) const { return points.subspan(idx * dim, dim); }
+
+    std::size_t build(std::size_t begin, std::size_t end, std::size_t parent);
+
+    std::optional<Idx> findNearest(std::span<Float const> point, Filter const &, bool activeOnly) const;
+    void findNearest(std::size_t nodeIdx, std::span<Float const> point, Filter const &, bool activeOnly,
+                     Nearest &) const;
+
+    std::span<Float const> points;
+    std::size_t dim;
+
+    std::vector<Idx> indices{};
+    std::vector<Node> nodes{};
+
+    // Of each point
+    std::vector<std::size_t> leaves{};
+    std::vector<bool> active{};
+};
+} // namespace xspace
+
+#endif // XSPACE_KDTREE_H
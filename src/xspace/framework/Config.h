@@ -7,6 +7,7 @@
 #include <xspace/nn/Dataset.h>
 
 #include <optional>
+#include <string>
 
 namespace xspace {
 //+ move parsing cmdline options here
@@ -32,11 +33,45 @@ public:
     void printIntervalExplanationsInIntervalFormat() {
         setPrintIntervalExplanationsFormat(IntervalExplanation::PrintFormat::intervals);
     }
+    void printIntervalExplanationsInBinaryFormat() {
+        setPrintIntervalExplanationsFormat(IntervalExplanation::PrintFormat::binary);
+    }
 
     void shuffleSamples() { _shuffleSamples = true; }
 
     void setMaxSamples(std::size_t n) { maxSamples = n; }
 
+    void setJobs(std::size_t n) { jobs = n; }
+    void setSpeculativeJobs(std::size_t n) { speculativeJobs = n; }
+
+    void usePersistentModel() { persistentModel = true; }
+
+    void useBoundPropagation() { boundPropagation = true; }
+
+    void useCounterexampleCache() { counterexampleCache = true; }
+
+    void useWarmStart() { warmStart = true; }
+
+    void useExplanationCache(std::string dirName) { explanationCacheDir = std::move(dirName); }
+
+    void useCheckpoint(std::string fileName) { checkpointFile = std::move(fileName); }
+    void resumeFromCheckpoint() { resume = true; }
+
+    // The output is flushed after each n samples, or only at the end if n = 0
+    void setOutputFlushPeriod(std::size_t n) { outputFlushPeriod = n; }
+    void flushOutputAtExit() { setOutputFlushPeriod(0); }
+
+    void useTrace(std::string fileName) { traceFile = std::move(fileName); }
+
+    // Neither the explanations nor the stats are printed, e.g. when the server returns them instead
+    void discardOutput() { outputDiscarded = true; }
+
+    // Zero means unlimited; the timeouts are in seconds
+    void setCheckTimeout(double t) { checkTimeout = t; }
+    void setCheckConflictLimit(std::size_t n) { checkConflictLimit = n; }
+    void setSampleTimeout(double t) { sampleTimeout = t; }
+    void setSampleConflictLimit(std::size_t n) { sampleConflictLimit = n; }
+
     void filterCorrectSamples() { optFilterCorrectSamples = true; }
     void filterIncorrectSamples() { optFilterCorrectSamples = false; }
     void filterSamplesOfExpectedClass(Dataset::Classification c) { optFilterSamplesOfExpectedClass = c; }
@@ -58,12 +93,51 @@ public:
     bool printingIntervalExplanationsInIntervalFormat() const {
         return intervalExplanationPrintFormat == IntervalExplanation::PrintFormat::intervals;
     }
+    bool printingIntervalExplanationsInBinaryFormat() const {
+        return intervalExplanationPrintFormat == IntervalExplanation::PrintFormat::binary;
+    }
 
     bool shufflingSamples() const { return _shuffleSamples; }
 
     std::size_t getMaxSamples() const { return maxSamples; }
     bool limitingMaxSamples() const { return getMaxSamples() > 0; }
 
+    std::size_t getJobs() const { return jobs; }
+    bool runningInParallel() const { return getJobs() > 1; }
+    std::size_t getSpeculativeJobs() const { return speculativeJobs; }
+    bool speculating() const { return getSpeculativeJobs() > 1; }
+
+    bool usingPersistentModel() const { return persistentModel; }
+
+    bool usingBoundPropagation() const { return boundPropagation; }
+
+    bool usingCounterexampleCache() const { return counterexampleCache; }
+
+    bool usingWarmStart() const { return warmStart; }
+
+    bool usingExplanationCache() const { return not explanationCacheDir.empty(); }
+    std::string const & getExplanationCacheDir() const { return explanationCacheDir; }
+
+    bool usingCheckpoint() const { return not checkpointFile.empty(); }
+    std::string const & getCheckpointFile() const { return checkpointFile; }
+    bool resumingFromCheckpoint() const { return resume; }
+
+    std::size_t getOutputFlushPeriod() const { return outputFlushPeriod; }
+    bool flushingOutputAtExit() const { return getOutputFlushPeriod() == 0; }
+
+    bool usingTrace() const { return not traceFile.empty(); }
+    std::string const & getTraceFile() const { return traceFile; }
+
+    bool discardingOutput() const { return outputDiscarded; }
+
+    double getCheckTimeout() const { return checkTimeout; }
+    std::size_t getCheckConflictLimit() const { return checkConflictLimit; }
+    double getSampleTimeout() const { return sampleTimeout; }
+    std::size_t getSampleConflictLimit() const { return sampleConflictLimit; }
+    bool usingBudgets() const {
+        return checkTimeout > 0 or checkConflictLimit > 0 or sampleTimeout > 0 or sampleConflictLimit > 0;
+    }
+
     bool filteringCorrectSamples() const { return optFilterCorrectSamples.has_value() and *optFilterCorrectSamples; }
     bool filteringIncorrectSamples() const {
         return optFilterCorrectSamples.has_value() and not *optFilterCorrectSamples;
@@ -85,6 +159,33 @@ protected:
 
     std::size_t maxSamples{};
 
+    std::size_t jobs{1};
+    std::size_t speculativeJobs{1};
+
+    bool persistentModel{};
+
+    bool boundPropagation{};
+
+    bool counterexampleCache{};
+
+    bool warmStart{};
+
+    std::string explanationCacheDir{};
+
+    std::string checkpointFile{};
+    bool resume{};
+
+    std::size_t outputFlushPeriod{1};
+
+    std::string traceFile{};
+
+    bool outputDiscarded{};
+
+    double checkTimeout{};
+    std::size_t checkConflictLimit{};
+    double sampleTimeout{};
+    std::size_t sampleConflictLimit{};
+
     std::optional<bool> optFilterCorrectSamples{};
     std::optional<Dataset::Classification> optFilterSamplesOfExpectedClass{};
 };
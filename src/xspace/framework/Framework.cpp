@@ -4,6 +4,7 @@
 #include "Parse.h"
 #include "Preprocess.h"
 #include "Print.h"
+#include "Trace.h"
 #include "expand/Expand.h"
 
 #include <xspace/common/Macro.h>
@@ -13,10 +14,13 @@
 
 #include <verifiers/Verifier.h>
 
+#include <fstream>
+
 namespace xspace {
 Framework::Framework() : Framework(Config{}) {}
 
 Framework::Framework(Config const & config) : configPtr{MAKE_UNIQUE(config)} {
+    if (config.usingTrace()) { tracePtr = std::make_unique<Trace>(); }
     expandPtr = std::make_unique<Expand>(*this);
     printPtr = std::make_unique<Print>(*this);
 }
@@ -68,6 +72,17 @@ void Framework::setExpand(std::string_view verifierName, std::istream & strategi
     expandPtr->setVerifier(verifierName);
 }
 
+std::size_t Framework::classificationSize() const {
+    auto const & network = getNetwork();
+    std::size_t const outputSize = network.getLayerSize(network.getNumLayers() - 1);
+    return (outputSize == 1) ? 2 : outputSize;
+}
+
+std::size_t Framework::computeClassificationLabel(std::span<Float const> sample) const {
+    xai::nn::NNet::input_t const input(sample.begin(), sample.end());
+    return Preprocess::computeClassificationLabel(xai::nn::computeOutput(input, getNetwork()));
+}
+
 Explanations Framework::explain(Dataset & data) {
     Preprocess preprocess{*this, data};
     auto explanations = preprocess.makeExplanationsFromSamples();
@@ -77,12 +92,16 @@ Explanations Framework::explain(Dataset & data) {
     return explanations;
 }
 
-Explanations Framework::expand(std::string_view fileName, Dataset & data) {
+Explanations Framework::parse(std::string_view fileName, Dataset & data) {
     Preprocess preprocess{*this, data};
-    Parse parse{*this};
+    Parse parser{*this};
 
     //++ only interval explanations supported, but general phis probably require a solver
-    auto explanations = parse.parseIntervalExplanations(fileName, data);
+    return parser.parseIntervalExplanations(fileName, data);
+}
+
+Explanations Framework::expand(std::string_view fileName, Dataset & data) {
+    auto explanations = parse(fileName, data);
 
     expand(explanations, data);
 
@@ -91,5 +110,16 @@ Explanations Framework::expand(std::string_view fileName, Dataset & data) {
 
 void Framework::expand(Explanations & explanations, Dataset const & data) {
     (*expandPtr)(explanations, data);
+
+    if (tracePtr) { writeTrace(); }
+}
+
+void Framework::writeTrace() const {
+    assert(tracePtr);
+    auto const & fileName = getConfig().getTraceFile();
+    std::ofstream ofs{fileName};
+    if (not ofs.good()) { throw std::ofstream::failure{"Could not open trace file "s + fileName}; }
+
+    tracePtr->write(ofs);
 }
 } // namespace xspace
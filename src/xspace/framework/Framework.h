@@ -9,6 +9,7 @@
 #include <cassert>
 #include <iosfwd>
 #include <memory>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -56,8 +57,16 @@ public:
 
     Interval const & getDomainInterval(VarIdx idx) const { return domainIntervals[idx]; }
 
+    // A single output value of the network is a binary classification
+    std::size_t classificationSize() const;
+    // Of the output of the network, as the computed classification of the samples of the datasets
+    std::size_t computeClassificationLabel(std::span<Float const> sample) const;
+
     Explanations explain(Dataset &);
 
+    // Only loads the explanations in a file, without any expansion
+    Explanations parse(std::string_view fileName, Dataset &);
+
     // Allows further expansion of explanations in a file
     Explanations expand(std::string_view fileName, Dataset &);
 
@@ -72,8 +81,12 @@ protected:
 
     class Print;
 
+    class Trace;
+
     using VarNames = std::vector<VarName>;
 
+    void writeTrace() const;
+
     Expand const & getExpand() const {
         assert(expandPtr);
         return *expandPtr;
@@ -85,6 +98,9 @@ protected:
     VarNames varNames{};
     std::vector<Interval> domainIntervals{};
 
+    // Must outlive the verifiers of the expansion
+    std::unique_ptr<Trace> tracePtr{};
+
     std::unique_ptr<Expand> expandPtr{};
 
     std::unique_ptr<Print> printPtr{};
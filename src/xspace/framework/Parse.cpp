@@ -9,10 +9,19 @@
 
 #include <cassert>
 #include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace xspace {
 Framework::Parse::Parse(Framework & fw) : framework{fw} {
     assert(not framework.varNames.empty());
@@ -22,7 +31,15 @@ Explanations Framework::Parse::parseIntervalExplanations(std::string_view fileNa
     std::ifstream ifs{std::string{fileName}};
     if (not ifs.good()) { throw std::ifstream::failure{"Could not open explanations file "s + std::string{fileName}}; }
 
-    //+ not assuming other formats so far
+    std::string magic(IntervalExplanation::BinaryHeader::magic.size(), '\0');
+    ifs.read(magic.data(), magic.size());
+    if (ifs and magic == IntervalExplanation::BinaryHeader::magic) {
+        ifs.close();
+        return parseIntervalExplanationsBinary(fileName, data);
+    }
+
+    ifs.clear();
+    ifs.seekg(0);
     return parseIntervalExplanationsSmtLib2(ifs, data);
 }
 
@@ -46,6 +63,114 @@ Explanations Framework::Parse::parseIntervalExplanationsSmtLib2(std::istream & i
     return explanations;
 }
 
+Explanations Framework::Parse::parseIntervalExplanationsBinary(std::string_view fileName, Dataset const & data) const {
+    std::string const fileNameStr{fileName};
+    auto const throwSystemError = [&fileNameStr](std::string const & msg) {
+        throw std::ifstream::failure{msg + " explanations file " + fileNameStr + ": " + std::strerror(errno)};
+    };
+
+    int const fd = ::open(fileNameStr.c_str(), O_RDONLY);
+    if (fd < 0) { throwSystemError("Could not open"); }
+
+    struct ::stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throwSystemError("Could not stat");
+    }
+    std::size_t const size = st.st_size;
+
+    void * addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the file is closed
+    ::close(fd);
+    if (addr == MAP_FAILED) { throwSystemError("Could not map"); }
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+
+    auto const unmap = [size](void * p) { ::munmap(p, size); };
+    std::unique_ptr<void, decltype(unmap)> mapGuard{addr, unmap};
+    return parseIntervalExplanationsBinary(std::span{static_cast<char const *>(addr), size}, data);
+}
+
+Explanations Framework::Parse::parseIntervalExplanationsBinary(std::span<char const> bytes,
+                                                               Dataset const & data) const {
+    using BinaryHeader = IntervalExplanation::BinaryHeader;
+
+    BinaryHeader header;
+    if (bytes.size() < sizeof(header)) { throw std::logic_error{"Truncated header of binary interval explanations"}; }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    bytes = bytes.subspan(sizeof(header));
+
+    if (std::string_view(header.magicBuf, sizeof(header.magicBuf)) != BinaryHeader::magic) {
+        throw std::logic_error{"Binary interval explanations miss the magic header"};
+    }
+    if (header.varSize != framework.varSize()) {
+        throw std::logic_error{"Binary interval explanations have a different no. variables: "s +
+                               std::to_string(header.varSize) + " != " + std::to_string(framework.varSize())};
+    }
+    if (header.floatSize != sizeof(Float)) {
+        throw std::logic_error{"Binary interval explanations have an incompatible floating-point size: "s +
+                               std::to_string(header.floatSize)};
+    }
+
+    std::size_t const maxSize = data.size();
+    Explanations explanations;
+    explanations.reserve(maxSize);
+
+    while (not bytes.empty()) {
+        if (explanations.size() == maxSize) {
+            throw std::logic_error{"Binary interval explanations have more records than the no. samples: "s +
+                                   std::to_string(maxSize)};
+        }
+        explanations.push_back(parseIntervalExplanationBinary(bytes));
+    }
+
+    return explanations;
+}
+
+std::unique_ptr<Explanation> Framework::Parse::parseIntervalExplanationBinary(std::span<char const> & bytes) const {
+    std::size_t const varSize = framework.varSize();
+    std::size_t const bitmapSize = IntervalExplanation::binaryBitmapSize(varSize);
+    if (bytes.size() < bitmapSize) { throw std::logic_error{"Truncated binary interval explanation"}; }
+    auto const bitmap = bytes.first(bitmapSize);
+    bytes = bytes.subspan(bitmapSize);
+
+    auto const readFloat = [&bytes] {
+        Float val;
+        std::memcpy(&val, bytes.data(), sizeof(val));
+        bytes = bytes.subspan(sizeof(val));
+        return val;
+    };
+
+    auto iexplanationPtr = std::make_unique<IntervalExplanation>(framework);
+    auto & iexplanation = *iexplanationPtr;
+    for (VarIdx idx = 0; idx < varSize; ++idx) {
+        if (not (bitmap[idx / 8] & (1 << (idx % 8)))) { continue; }
+
+        if (bytes.size() < 2 * sizeof(Float)) { throw std::logic_error{"Truncated binary interval explanation"}; }
+        Float const lo = readFloat();
+        Float const hi = readFloat();
+        // Infinite at most on the side of the bound that is missing
+        constexpr Float infinity = std::numeric_limits<Float>::infinity();
+        bool const valid = not std::isnan(lo) and not std::isnan(hi) and lo <= hi and lo != infinity and
+                           hi != -infinity and not (std::isinf(lo) and std::isinf(hi));
+        if (not valid) {
+            throw std::invalid_argument{"Invalid interval of variable "s + std::to_string(idx) +
+                                        " in a binary interval explanation: [" + std::to_string(lo) + ", " +
+                                        std::to_string(hi) + "]"};
+        }
+        if (lo == hi) {
+            iexplanation.insertVarBound(VarBound{framework, idx, EqBound{lo}});
+        } else if (std::isinf(lo)) {
+            iexplanation.insertVarBound(VarBound{framework, idx, UpperBound{hi}});
+        } else if (std::isinf(hi)) {
+            iexplanation.insertVarBound(VarBound{framework, idx, LowerBound{lo}});
+        } else {
+            iexplanation.insertVarBound(VarBound{framework, idx, LowerBound{lo}, UpperBound{hi}});
+        }
+    }
+
+    return iexplanationPtr;
+}
+
 namespace {
     //+ only assertions
     long parseInt(std::istream & is) {
@@ -3,6 +3,8 @@
 
 #include "Framework.h"
 
+#include <span>
+
 namespace xspace {
 class Dataset;
 
@@ -16,6 +18,12 @@ protected:
     Explanations parseIntervalExplanationsSmtLib2(std::istream &, Dataset const &) const;
     std::unique_ptr<Explanation> parseIntervalExplanationSmtLib2(std::istream &) const;
 
+    // The file is memory-mapped and the records are loaded directly, without any tokenizing
+    Explanations parseIntervalExplanationsBinary(std::string_view fileName, Dataset const &) const;
+    Explanations parseIntervalExplanationsBinary(std::span<char const>, Dataset const &) const;
+    // Consumes the record from the beginning of the span
+    std::unique_ptr<Explanation> parseIntervalExplanationBinary(std::span<char const> &) const;
+
     Framework & framework;
 };
 } // namespace xspace
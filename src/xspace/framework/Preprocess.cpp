@@ -1,5 +1,7 @@
 #include "Preprocess.h"
 
+#include "Config.h"
+
 #include "explanation/IntervalExplanation.h"
 #include "explanation/VarBound.h"
 
@@ -19,16 +21,28 @@ Framework::Preprocess::Preprocess(Framework & fw, Dataset & data) : framework{fw
 }
 
 void Framework::Preprocess::initDataset() {
-    auto const & samples = dataset.getSamples();
+    static_assert(std::same_as<Dataset::Sample::value_type, float>);
+    static_assert(std::same_as<Dataset::Output::Values::value_type, float>);
+
     std::size_t const size = dataset.size();
-    assert(size == samples.size());
-    assert(not samples.empty());
+    assert(size > 0);
+    assert(dataset.sampleSize() == framework.varSize());
+
+    // The whole dataset is computed at once as a batch
+    auto const inputs = dataset.getSamplesData();
+    auto & network = framework.getNetwork();
+    std::size_t const nThreads = framework.getConfig().getJobs();
+    auto const outputsValues = xai::nn::computeOutputs(inputs, size, network, nThreads);
+    std::size_t const outputSize = outputsValues.size() / size;
+    assert(outputsValues.size() == size * outputSize);
+
     Dataset::Outputs outputs;
     outputs.reserve(size);
-    for (auto const & sample : samples) {
-        assert(sample.size() == framework.varSize());
-        Dataset::Output output = computeOutput(sample);
-        outputs.push_back(std::move(output));
+    for (std::size_t i = 0; i < size; ++i) {
+        auto const begin = outputsValues.begin() + i * outputSize;
+        Dataset::Output::Values outputValues(begin, begin + outputSize);
+        auto label = computeClassificationLabel(outputValues);
+        outputs.push_back({.classificationLabel = label, .values = std::move(outputValues)});
     }
 
     assert(outputs.size() == size);
@@ -58,12 +72,12 @@ Explanations Framework::Preprocess::makeExplanationsFromSamples() const {
 }
 
 Dataset::Output Framework::Preprocess::computeOutput(Dataset::Sample const & sample) const {
-    static_assert(std::derived_from<Dataset::Sample, xai::nn::NNet::input_t>);
     static_assert(std::derived_from<Dataset::Output::Values, xai::nn::NNet::output_t>);
 
     auto & network = framework.getNetwork();
 
-    Dataset::Output::Values outputValues = xai::nn::computeOutput(sample, network);
+    xai::nn::NNet::input_t const input(sample.begin(), sample.end());
+    Dataset::Output::Values outputValues = xai::nn::computeOutput(input, network);
     auto label = computeClassificationLabel(outputValues);
 
     return {.classificationLabel = label, .values = std::move(outputValues)};
@@ -3,14 +3,96 @@
 #include "Config.h"
 
 #include <iostream>
+#include <utility>
 
 namespace xspace {
-Framework::Print::Print(Framework const & fw) : framework{fw}, explanationsOsPtr{&std::cout} {
+Framework::Print::Print(Framework const & fw) : framework{fw} {
     auto const & conf = framework.getConfig();
+    if (conf.discardingOutput()) { return; }
+
+    explanationsOsPtr = &std::cout;
+
     bool const verbose = conf.isVerbose();
 
     if (not verbose) { return; }
 
     statsOsPtr = &std::cerr;
 }
+
+Framework::Print::Writer::Writer(Print const & print_)
+    : print{print_},
+      flushPeriod{print.framework.getConfig().getOutputFlushPeriod()},
+      thread{[this] { run(); }} {}
+
+Framework::Print::Writer::~Writer() {
+    try {
+        finish();
+    } catch (...) {
+    }
+}
+
+void Framework::Print::Writer::submit(SampleOutput output) {
+    {
+        std::lock_guard lock{mutex};
+        assert(not stopping);
+        queue.push_back(std::move(output));
+    }
+    condition.notify_one();
+}
+
+void Framework::Print::Writer::finish() {
+    if (thread.joinable()) {
+        {
+            std::lock_guard lock{mutex};
+            stopping = true;
+        }
+        condition.notify_one();
+        thread.join();
+    }
+
+    if (exceptionPtr) { std::rethrow_exception(std::exchange(exceptionPtr, nullptr)); }
+}
+
+void Framework::Print::Writer::run() {
+    bool const printingStats = not print.ignoringStats();
+    bool const printingExplanations = not print.ignoringExplanations();
+
+    std::deque<SampleOutput> outputs;
+    try {
+        while (true) {
+            {
+                std::unique_lock lock{mutex};
+                condition.wait(lock, [this] { return not queue.empty() or stopping; });
+                if (queue.empty()) { break; }
+                // Take all the available outputs at once to not hold the lock while writing
+                std::swap(outputs, queue);
+            }
+
+            for (auto & output : outputs) {
+                if (printingStats) { print.stats() << output.stats; }
+                if (printingExplanations) { print.explanations() << output.explanation; }
+                if (output.onFlushed) { pendingCallbacks.push_back(std::move(output.onFlushed)); }
+
+                ++unflushedCount;
+                if (flushPeriod > 0 and unflushedCount >= flushPeriod) { flush(); }
+            }
+            outputs.clear();
+        }
+
+        flush();
+    } catch (...) {
+        exceptionPtr = std::current_exception();
+    }
+}
+
+void Framework::Print::Writer::flush() {
+    if (not print.ignoringStats()) { print.stats().flush(); }
+    if (not print.ignoringExplanations()) { print.explanations().flush(); }
+    unflushedCount = 0;
+
+    for (auto & callback : pendingCallbacks) {
+        callback();
+    }
+    pendingCallbacks.clear();
+}
 } // namespace xspace
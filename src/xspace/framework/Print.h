@@ -6,11 +6,21 @@
 #include <xspace/common/Print.h>
 
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
 #include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace xspace {
 class Framework::Print {
 public:
+    class Writer;
+
     Print(Framework const &);
 
     bool ignoringExplanations() const { return ignoring(explanationsOsPtr); }
@@ -42,6 +52,51 @@ protected:
     std::ostream * explanationsOsPtr{&absorb};
     std::ostream * statsOsPtr{&absorb};
 };
+
+// Output stage that writes the buffered outputs of the samples in a background thread,
+// so that the expansion of the samples does not wait for the output streams
+// The outputs are written in the order of submission and flushed according to Config::getOutputFlushPeriod
+class Framework::Print::Writer {
+public:
+    struct SampleOutput {
+        std::string explanation{};
+        std::string stats{};
+        // Called once the output is written and flushed
+        std::function<void()> onFlushed{};
+    };
+
+    Writer(Print const &);
+    ~Writer();
+    Writer(Writer const &) = delete;
+    Writer & operator=(Writer const &) = delete;
+
+    void submit(SampleOutput);
+
+    // Writes and flushes all the submitted outputs and stops the writer
+    // Rethrows the exception of the writer thread, if any
+    void finish();
+
+protected:
+    void run();
+
+    void flush();
+
+    Print const & print;
+
+    std::size_t const flushPeriod;
+
+    std::deque<SampleOutput> queue{};
+    bool stopping{};
+    std::mutex mutex{};
+    std::condition_variable condition{};
+
+    std::size_t unflushedCount{};
+    std::vector<std::function<void()>> pendingCallbacks{};
+    std::exception_ptr exceptionPtr{};
+
+    // Must be the last member so that the thread only runs while the other members are alive
+    std::jthread thread;
+};
 } // namespace xspace
 
 #endif // XSPACE_FRAMEWORK_PRINT_H
@@ -0,0 +1,152 @@
+#include "Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace xspace {
+namespace {
+    using Verifier = xai::verifiers::Verifier;
+
+    std::string_view callName(Verifier::Tracer::Call call) {
+        using enum Verifier::Tracer::Call;
+        switch (call) {
+            case loadModel:
+                return "loadModel";
+            case push:
+                return "push";
+            case pop:
+                return "pop";
+            case check:
+                return "check";
+        }
+        return "";
+    }
+
+    std::string_view answerName(Verifier::Answer answer) {
+        using enum Verifier::Answer;
+        switch (answer) {
+            case SAT:
+                return "sat";
+            case UNSAT:
+                return "unsat";
+            case UNKNOWN:
+                return "unknown";
+            case ERROR:
+                return "error";
+        }
+        return "";
+    }
+
+    void writeJsonString(std::ostream & os, std::string_view str) {
+        os << '"';
+        for (char c : str) {
+            if (c == '"' or c == '\\') {
+                os << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+            } else {
+                os << c;
+            }
+        }
+        os << '"';
+    }
+
+    void appendArg(std::string & args, std::string_view key, std::string_view jsonValue) {
+        if (not args.empty()) { args += ','; }
+        args += '"';
+        args += key;
+        args += "\":";
+        args += jsonValue;
+    }
+} // namespace
+
+Framework::Trace::Trace() : startTime{Clock::now()} {}
+
+void Framework::Trace::traceCall(CallInfo const & info) {
+    std::string args;
+    if (info.call == Call::check) {
+        appendArg(args, "answer", '"' + std::string{answerName(info.answer)} + '"');
+        appendArg(args, "terms", std::to_string(info.terms));
+        if (info.assumptions > 0) { appendArg(args, "assumptions", std::to_string(info.assumptions)); }
+    }
+
+    record(callName(info.call), "verifier", info.start, info.end, std::move(args));
+}
+
+void Framework::Trace::record(std::string_view name, std::string_view category, Clock::time_point start,
+                              Clock::time_point end, std::string args) {
+    Event event{.name = std::string{name},
+                .category = category,
+                .threadId = getThreadId(),
+                .start = start,
+                .end = end,
+                .args = std::move(args)};
+
+    std::lock_guard lock{mutex};
+    events.push_back(std::move(event));
+}
+
+void Framework::Trace::write(std::ostream & os) const {
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    std::lock_guard lock{mutex};
+    auto const origFlags = os.flags();
+    auto const origPrecision = os.precision();
+    // Microseconds with a fixed resolution, also for long runs
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (auto const & event : events) {
+        if (not first) { os << ','; }
+        first = false;
+
+        os << "\n{\"name\":";
+        writeJsonString(os, event.name);
+        os << ",\"cat\":";
+        writeJsonString(os, event.category);
+        os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId;
+        os << ",\"ts\":" << Micros(event.start - startTime).count();
+        os << ",\"dur\":" << Micros(event.end - event.start).count();
+        if (not event.args.empty()) { os << ",\"args\":{" << event.args << '}'; }
+        os << '}';
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    os.flags(origFlags);
+    os.precision(origPrecision);
+}
+
+std::size_t Framework::Trace::getThreadId() {
+    static std::atomic<std::size_t> nextId{};
+    thread_local std::size_t const id = nextId++;
+    return id;
+}
+
+Framework::Trace::Scope::Scope(Trace * trace, std::string_view name_, std::string_view category_)
+    : tracePtr{trace},
+      name{name_},
+      category{category_} {
+    if (tracePtr) { start = Clock::now(); }
+}
+
+Framework::Trace::Scope::~Scope() {
+    if (not tracePtr) { return; }
+    tracePtr->record(name, category, start, Clock::now(), std::move(args));
+}
+
+void Framework::Trace::Scope::addArg(std::string_view key, std::size_t value) {
+    if (not tracePtr) { return; }
+    appendArg(args, key, std::to_string(value));
+}
+
+void Framework::Trace::Scope::addArg(std::string_view key, std::string_view value) {
+    if (not tracePtr) { return; }
+    std::ostringstream oss;
+    writeJsonString(oss, value);
+    appendArg(args, key, std::move(oss).str());
+}
+} // namespace xspace
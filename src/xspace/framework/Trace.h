@@ -0,0 +1,72 @@
+#ifndef XSPACE_FRAMEWORK_TRACE_H
+#define XSPACE_FRAMEWORK_TRACE_H
+
+#include "Framework.h"
+
+#include <verifiers/Verifier.h>
+
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xspace {
+// Records the durations of the calls of the verifiers and of the expansion of the samples
+// The trace is written in the Chrome trace event format, which can be viewed e.g. in Perfetto
+class Framework::Trace : public xai::verifiers::Verifier::Tracer {
+public:
+    // Records a single event from its construction until its destruction
+    class Scope;
+
+    Trace();
+
+    void traceCall(CallInfo const &) override;
+
+    // The arguments must be the members of a JSON object
+    void record(std::string_view name, std::string_view category, Clock::time_point start, Clock::time_point end,
+                std::string args = {});
+
+    void write(std::ostream &) const;
+
+protected:
+    struct Event {
+        std::string name;
+        std::string_view category;
+        std::size_t threadId;
+        Clock::time_point start;
+        Clock::time_point end;
+        std::string args;
+    };
+
+    // Small numbers that are more readable than the native thread identifiers
+    static std::size_t getThreadId();
+
+    Clock::time_point const startTime;
+
+    std::vector<Event> events{};
+    mutable std::mutex mutex{};
+};
+
+class Framework::Trace::Scope {
+public:
+    // Does nothing if the trace is null
+    Scope(Trace *, std::string_view name, std::string_view category);
+    ~Scope();
+    Scope(Scope const &) = delete;
+    Scope & operator=(Scope const &) = delete;
+
+    void addArg(std::string_view key, std::size_t value);
+    void addArg(std::string_view key, std::string_view value);
+
+protected:
+    Trace * tracePtr;
+    std::string_view name;
+    std::string_view category;
+    Clock::time_point start{};
+    std::string args{};
+};
+} // namespace xspace
+
+#endif // XSPACE_FRAMEWORK_TRACE_H
@@ -0,0 +1,144 @@
+#include "Checkpoint.h"
+
+#include "../explanation/IntervalExplanation.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace xspace {
+namespace {
+// Header: "xspace checkpoint 1 <context hash>\n"
+// Record: "sample <idx> <payload size> <checksum>\n<payload>"
+// The payload is an explanation cache entry, or empty if the explanation is not an interval explanation
+constexpr std::string_view header = "xspace checkpoint 1";
+constexpr std::string_view recordTag = "sample";
+
+std::uint64_t checksum(std::string_view str) {
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (char c : str) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+    }
+    return hash;
+}
+
+[[noreturn]] void throwSystemError(std::string const & msg, std::string const & fileName) {
+    throw std::runtime_error{msg + ": " + fileName + ": " + std::strerror(errno)};
+}
+} // namespace
+
+Framework::Expand::Checkpoint::Checkpoint(Framework const & fw, Dataset const & data, std::string_view fn,
+                                          std::string_view context, bool resume)
+    : framework{fw},
+      fileName{fn} {
+    ExplanationCache::Hash hash;
+    hash.update(header);
+    hash.update(context);
+    ExplanationCache::hashNetwork(hash, framework.getNetwork());
+    hash.update(data.getSamplesData());
+    headerLine = std::string{header} + ' ' + hash.toHex() + '\n';
+
+    std::size_t validSize = 0;
+    if (resume) { validSize = readLog(); }
+
+    int const flags = O_WRONLY | O_CREAT | (resume ? 0 : O_TRUNC);
+    fd = ::open(fileName.c_str(), flags, 0644);
+    if (fd < 0) { throwSystemError("Could not open the checkpoint", fileName); }
+
+    // Drop the torn record, if any, so that the new records directly follow the valid ones
+    if (resume and ::ftruncate(fd, validSize) != 0) { throwSystemError("Could not truncate the checkpoint", fileName); }
+    if (::lseek(fd, 0, SEEK_END) < 0) { throwSystemError("Could not seek in the checkpoint", fileName); }
+
+    if (validSize == 0) { writeAll(headerLine); }
+}
+
+Framework::Expand::Checkpoint::~Checkpoint() {
+    if (fd >= 0) { ::close(fd); }
+}
+
+std::size_t Framework::Expand::Checkpoint::readLog() {
+    std::ifstream ifs{fileName, std::ios::binary};
+    if (not ifs) { return 0; }
+    std::string const contents{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+
+    // A torn header is the same as an empty log
+    if (contents.size() < headerLine.size() and headerLine.starts_with(contents)) { return 0; }
+    if (not contents.starts_with(headerLine)) {
+        throw std::invalid_argument{"The checkpoint was written with a different model, dataset or options: "s +
+                                    fileName};
+    }
+
+    std::size_t pos = headerLine.size();
+    while (pos < contents.size()) {
+        std::size_t const headerEnd = contents.find('\n', pos);
+        if (headerEnd == std::string::npos) { break; }
+
+        std::istringstream headerIss{contents.substr(pos, headerEnd - pos)};
+        std::string tag;
+        Dataset::Sample::Idx idx;
+        std::size_t payloadSize;
+        std::uint64_t sum;
+        if (not (headerIss >> tag >> idx >> payloadSize >> std::hex >> sum) or tag != recordTag) { break; }
+
+        std::size_t const payloadBegin = headerEnd + 1;
+        if (payloadBegin + payloadSize > contents.size()) { break; }
+        std::string_view const payload{contents.data() + payloadBegin, payloadSize};
+        if (checksum(payload) != sum) { break; }
+
+        Entry entry{};
+        if (not payload.empty()) {
+            std::istringstream payloadIss{std::string{payload}};
+            entry = ExplanationCache::readEntry(framework, payloadIss);
+        }
+        completed.insert_or_assign(idx, std::move(entry));
+
+        pos = payloadBegin + payloadSize;
+    }
+
+    return pos;
+}
+
+std::unique_ptr<IntervalExplanation> Framework::Expand::Checkpoint::takeExplanation(Dataset::Sample::Idx idx) {
+    auto const it = completed.find(idx);
+    assert(it != completed.end());
+    return std::move(it->second.explanationPtr);
+}
+
+void Framework::Expand::Checkpoint::record(Dataset::Sample::Idx idx, Explanation const & explanation,
+                                           SampleStats const & stats) {
+    std::ostringstream payloadOss;
+    if (auto * iexplanationPtr = dynamic_cast<IntervalExplanation const *>(&explanation)) {
+        ExplanationCache::writeEntry(payloadOss, *iexplanationPtr, stats);
+    }
+    std::string const payload = std::move(payloadOss).str();
+
+    std::ostringstream recordOss;
+    recordOss << recordTag << ' ' << idx << ' ' << payload.size() << ' ' << std::hex << checksum(payload) << '\n';
+    recordOss << payload;
+    std::string const record = std::move(recordOss).str();
+
+    std::lock_guard lock{mutex};
+    writeAll(record);
+}
+
+void Framework::Expand::Checkpoint::writeAll(std::string_view str) {
+    std::size_t written = 0;
+    while (written < str.size()) {
+        auto const n = ::write(fd, str.data() + written, str.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            throwSystemError("Could not write to the checkpoint", fileName);
+        }
+        written += n;
+    }
+    if (::fsync(fd) != 0) { throwSystemError("Could not sync the checkpoint", fileName); }
+}
+} // namespace xspace
@@ -0,0 +1,57 @@
+#ifndef XSPACE_EXPAND_CHECKPOINT_H
+#define XSPACE_EXPAND_CHECKPOINT_H
+
+#include "ExplanationCache.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace xspace {
+class IntervalExplanation;
+
+// Append-only log of the completed samples with their explanations and stats
+// Each record is checksummed and synced to the disk, a torn record at the end (after a crash) is dropped
+// Only interval explanations can be restored, the other samples are recorded as completed without them
+// The log starts with a hash of the model, the dataset and the context of the run,
+// and it can only be resumed by a run with the same hash
+class Framework::Expand::Checkpoint {
+public:
+    using Entry = ExplanationCache::Entry;
+
+    // Without resuming, any existing log is overwritten
+    // The context covers what the results and the selection of the samples depend on apart from the model and the data
+    Checkpoint(Framework const &, Dataset const &, std::string_view fileName, std::string_view context, bool resume);
+    ~Checkpoint();
+    Checkpoint(Checkpoint const &) = delete;
+    Checkpoint & operator=(Checkpoint const &) = delete;
+
+    bool isCompleted(Dataset::Sample::Idx idx) const { return completed.contains(idx); }
+    std::size_t completedCount() const { return completed.size(); }
+
+    // Null if the explanation could not be restored
+    std::unique_ptr<IntervalExplanation> takeExplanation(Dataset::Sample::Idx);
+
+    void record(Dataset::Sample::Idx, Explanation const &, SampleStats const &);
+
+protected:
+    // Returns the size of the valid prefix of the log, zero if the log is missing or empty
+    std::size_t readLog();
+
+    void writeAll(std::string_view);
+
+    Framework const & framework;
+
+    std::string fileName;
+    std::string headerLine;
+    int fd{-1};
+
+    std::map<Dataset::Sample::Idx, Entry> completed{};
+
+    std::mutex mutex{};
+};
+} // namespace xspace
+
+#endif // XSPACE_EXPAND_CHECKPOINT_H
@@ -0,0 +1,81 @@
+#include "CounterexampleCache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#if defined(__AVX512F__) or defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace xspace {
+namespace {
+constexpr std::size_t vectorWidth = 16;
+
+// All arrays are padded to the size, which is a multiple of the vector width
+bool pointIsInBox(Float const * point, Float const * lower, Float const * upper, std::size_t paddedSize) {
+#if defined(__AVX512F__)
+    for (std::size_t i = 0; i < paddedSize; i += vectorWidth) {
+        __m512 const x = _mm512_loadu_ps(point + i);
+        __mmask16 const inside = _mm512_cmp_ps_mask(_mm512_loadu_ps(lower + i), x, _CMP_LE_OQ) &
+                                 _mm512_cmp_ps_mask(x, _mm512_loadu_ps(upper + i), _CMP_LE_OQ);
+        if (inside != 0xFFFF) { return false; }
+    }
+    return true;
+#elif defined(__AVX2__)
+    for (std::size_t i = 0; i < paddedSize; i += 8) {
+        __m256 const x = _mm256_loadu_ps(point + i);
+        __m256 const inside = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(lower + i), x, _CMP_LE_OQ),
+                                            _mm256_cmp_ps(x, _mm256_loadu_ps(upper + i), _CMP_LE_OQ));
+        if (_mm256_movemask_ps(inside) != 0xFF) { return false; }
+    }
+    return true;
+#else
+    // Branchless within a block such that it can be auto-vectorized
+    for (std::size_t i = 0; i < paddedSize; i += vectorWidth) {
+        bool inside = true;
+        for (std::size_t j = i; j < i + vectorWidth; ++j) {
+            inside &= (lower[j] <= point[j]) & (point[j] <= upper[j]);
+        }
+        if (not inside) { return false; }
+    }
+    return true;
+#endif
+}
+} // namespace
+
+Framework::Expand::CounterexampleCache::CounterexampleCache(std::size_t vSize)
+    : varSize{vSize},
+      stride{(varSize + vectorWidth - 1) / vectorWidth * vectorWidth} {
+    assert(varSize > 0);
+    paddedLower.resize(stride, -std::numeric_limits<Float>::infinity());
+    paddedUpper.resize(stride, std::numeric_limits<Float>::infinity());
+}
+
+void Framework::Expand::CounterexampleCache::insert(std::span<Float const> point) {
+    assert(point.size() == varSize);
+    assert(nextPos < maxSize);
+
+    std::size_t const requiredSize = (nextPos + 1) * stride;
+    if (points.size() < requiredSize) { points.resize(requiredSize); }
+    std::ranges::copy(point, points.begin() + nextPos * stride);
+
+    nextPos = (nextPos + 1) % maxSize;
+    if (count < maxSize) { ++count; }
+}
+
+bool Framework::Expand::CounterexampleCache::containsPointIn(InputBox const & box) const {
+    if (empty()) { return false; }
+
+    assert(box.lower.size() == varSize);
+    assert(box.upper.size() == varSize);
+    std::ranges::copy(box.lower, paddedLower.begin());
+    std::ranges::copy(box.upper, paddedUpper.begin());
+
+    // Backwards from the most recent row, wrapping around the ring buffer
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t const pos = (nextPos + maxSize - 1 - i) % maxSize;
+        if (pointIsInBox(points.data() + pos * stride, paddedLower.data(), paddedUpper.data(), stride)) { return true; }
+    }
+    return false;
+}
+} // namespace xspace
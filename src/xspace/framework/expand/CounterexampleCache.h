@@ -0,0 +1,48 @@
+#ifndef XSPACE_EXPAND_COUNTEREXAMPLECACHE_H
+#define XSPACE_EXPAND_COUNTEREXAMPLECACHE_H
+
+#include "Expand.h"
+
+#include <span>
+#include <vector>
+
+namespace xspace {
+// Concrete inputs that are known to violate the classification of the current sample
+// Any explanation candidate that contains one of them is not an explanation, hence it need not be checked
+class Framework::Expand::CounterexampleCache {
+public:
+    // The oldest counterexample is replaced when the cache is full
+    static constexpr std::size_t maxSize = 1024;
+
+    CounterexampleCache(std::size_t varSize);
+
+    std::size_t size() const { return count; }
+    bool empty() const { return size() == 0; }
+
+    void insert(std::span<Float const> point);
+
+    // The most recent counterexamples are tried first
+    bool containsPointIn(InputBox const &) const;
+
+    void clear() {
+        count = 0;
+        nextPos = 0;
+    }
+
+protected:
+    std::size_t varSize;
+    // The rows are padded to a multiple of the vector width
+    std::size_t stride;
+
+    // Ring buffer of the rows, `nextPos` is the row of the next insertion
+    std::vector<Float> points{};
+    std::size_t count{};
+    std::size_t nextPos{};
+
+    // The padding of the box never excludes a point
+    mutable std::vector<Float> paddedLower{};
+    mutable std::vector<Float> paddedUpper{};
+};
+} // namespace xspace
+
+#endif // XSPACE_EXPAND_COUNTEREXAMPLECACHE_H
@@ -3,29 +3,79 @@
 #include "../Config.h"
 #include "../Preprocess.h"
 #include "../Print.h"
+#include "../Trace.h"
+#include "../Utils.h"
 #include "../explanation/Explanation.h"
+#include "../explanation/IntervalExplanation.h"
+#include "Checkpoint.h"
+#include "CounterexampleCache.h"
+#include "ExplanationCache.h"
+#include "WarmStart.h"
 #include "strategy/Factory.h"
 #include "strategy/Strategy.h"
 
 #include <xspace/common/Core.h>
 #include <xspace/common/String.h>
 
+#include <nn/IntervalBoundPropagation.h>
+#include <nn/NNet.h>
 #include <verifiers/Verifier.h>
+#include <verifiers/deeppoly/DeepPolyVerifier.h>
 #include <verifiers/opensmt/OpenSMTVerifier.h>
 #ifdef MARABOU
 #include <verifiers/marabou/MarabouVerifier.h>
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cassert>
+#include <condition_variable>
+#include <exception>
 #include <iomanip>
+#include <mutex>
 #include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 namespace xspace {
+namespace {
+// Runs f(0), ..., f(n-1) in parallel, the last one in the calling thread
+void runInParallel(std::size_t n, auto const & f) {
+    if (n == 0) { return; }
+
+    std::vector<std::exception_ptr> exceptionPtrs(n);
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(n - 1);
+        for (std::size_t i = 0; i < n - 1; ++i) {
+            threads.emplace_back([&, i] {
+                try {
+                    f(i);
+                } catch (...) {
+                    exceptionPtrs[i] = std::current_exception();
+                }
+            });
+        }
+        try {
+            f(n - 1);
+        } catch (...) {
+            exceptionPtrs[n - 1] = std::current_exception();
+        }
+    }
+
+    for (auto & exceptionPtr : exceptionPtrs) {
+        if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+    }
+}
+} // namespace
+
 Framework::Expand::Expand(Framework & fw) : framework{fw} {}
 
+Framework::Expand::~Expand() = default;
+
 void Framework::Expand::setStrategies(std::istream & is) {
     // pipe character '|' reserved for disjunctions
     static constexpr char strategyDelim = ';';
@@ -41,11 +91,15 @@ void Framework::Expand::setStrategies(std::istream & is) {
     while (std::getline(is, line, strategyDelim)) {
         auto strategyPtr = factory.parse(line);
         addStrategy(std::move(strategyPtr));
+
+        if (not strategiesSpec.empty()) { strategiesSpec += strategyDelim; }
+        strategiesSpec += line;
     }
 }
 
 void Framework::Expand::addStrategy(std::unique_ptr<Strategy> strategy) {
     requiresSMTSolver |= strategy->requiresSMTSolver();
+    requiresInputModels |= strategy->requiresInputModels();
 
     strategies.push_back(std::move(strategy));
 }
@@ -55,6 +109,22 @@ std::unique_ptr<xai::verifiers::Verifier> Framework::Expand::makeVerifier(std::s
     if (name.empty() and not requiresSMTSolver) { name = "marabou"sv; }
 #endif
 
+    // E.g. 'deeppoly+opensmt' uses the exact verifier for the queries that DeepPoly does not prove
+    if (toLower(name).starts_with("deeppoly")) {
+        if (requiresSMTSolver) {
+            throw std::invalid_argument{"The strategies require the SMT solver, got verifier: "s + std::string{name}};
+        }
+
+        constexpr std::string_view deepPolyName = "deeppoly"sv;
+        std::string_view fallbackName = name.substr(deepPolyName.size());
+        if (fallbackName.empty()) { return std::make_unique<xai::verifiers::DeepPolyVerifier>(); }
+        if (not fallbackName.starts_with('+')) {
+            throw std::invalid_argument{"Unrecognized verifier name: "s + std::string{name}};
+        }
+        fallbackName.remove_prefix(1);
+        return std::make_unique<xai::verifiers::DeepPolyVerifier>(makeVerifier(fallbackName));
+    }
+
     if (name.empty() or toLower(name) == "opensmt") {
         return std::make_unique<xai::verifiers::OpenSMTVerifier>();
 #ifdef MARABOU
@@ -72,11 +142,26 @@ void Framework::Expand::setVerifier() {
 
 void Framework::Expand::setVerifier(std::string_view name) {
     setVerifier(makeVerifier(name));
+    verifierName = name;
 }
 
 void Framework::Expand::setVerifier(std::unique_ptr<xai::verifiers::Verifier> vf) {
     assert(vf);
     verifierPtr = std::move(vf);
+    verifierInitialized = false;
+}
+
+std::unique_ptr<Framework::Expand> Framework::Expand::makeWorker() const {
+    return makeWorker(strategiesSpec, verifierName);
+}
+
+std::unique_ptr<Framework::Expand> Framework::Expand::makeWorker(std::string const & spec,
+                                                                 std::string_view vfName) const {
+    auto workerPtr = std::make_unique<Expand>(framework);
+    std::istringstream strategiesSpecIss{spec};
+    workerPtr->setStrategies(strategiesSpecIss);
+    workerPtr->setVerifier(vfName);
+    return workerPtr;
 }
 
 Dataset::SampleIndices Framework::Expand::makeSampleIndices(Dataset const & data) const {
@@ -123,48 +208,408 @@ void Framework::Expand::operator()(Explanations & explanations, Dataset const &
                                     std::to_string(explanations.size()) + " < " + std::to_string(data.size())};
     }
 
+    auto const & config = framework.getConfig();
+    // The explanations would depend on which neighbors the other workers have explained so far
+    if (config.usingWarmStart() and config.runningInParallel()) {
+        throw std::invalid_argument{"The warm start does not support parallel jobs"};
+    }
+    // Otherwise the whole run would silently start over
+    if (config.resumingFromCheckpoint() and not config.usingCheckpoint()) {
+        throw std::invalid_argument{"Resuming requires a checkpoint file"};
+    }
+    // The samples are recorded only once their output is flushed, hence no progress would be saved before the end
+    if (config.usingCheckpoint() and config.flushingOutputAtExit()) {
+        throw std::invalid_argument{"The checkpoint does not support flushing the output only at exit"};
+    }
+    if (config.usingWarmStart()) { warmStartPtr = std::make_shared<WarmStart>(data, explanations); }
+    if (config.usingExplanationCache()) { initExplanationCache(); }
+    if (config.usingCheckpoint()) {
+        checkpointPtr = std::make_unique<Checkpoint>(framework, data, config.getCheckpointFile(),
+                                                     makeCheckpointContext(), config.resumingFromCheckpoint());
+    }
+
+    Dataset::SampleIndices indices = makeSampleIndices(data);
+
     Print & print = *framework.printPtr;
     bool const printingStats = not print.ignoringStats();
-    bool const printingExplanations = not print.ignoringExplanations();
-    auto & cexp = print.explanations();
+    // When resuming, the output continues the output of the interrupted run
+    bool const resuming = (checkpointPtr and checkpointPtr->completedCount() > 0);
+    if (printingStats and not resuming) { printStatsHead(data); }
+    if (config.printingIntervalExplanationsInBinaryFormat() and not print.ignoringExplanations() and not resuming) {
+        IntervalExplanation::printBinaryHeader(print.explanations(), framework.varSize());
+    }
 
-    if (printingStats) { printStatsHead(data); }
+    if (resuming) { skipCompletedSamples(explanations, indices); }
 
-    initVerifier();
+    if (framework.getConfig().runningInParallel()) {
+        expandParallel(explanations, data, indices);
+    } else {
+        expandSequential(explanations, data, indices);
+    }
+}
+
+void Framework::Expand::skipCompletedSamples(Explanations & explanations, Dataset::SampleIndices & indices) {
+    assert(checkpointPtr);
+    auto & checkpoint = *checkpointPtr;
+    std::erase_if(indices, [&](Dataset::Sample::Idx idx) {
+        if (not checkpoint.isCompleted(idx)) { return false; }
+
+        if (auto iexplanationPtr = checkpoint.takeExplanation(idx)) { explanations[idx] = std::move(iexplanationPtr); }
+        if (warmStartPtr) { warmStartPtr->markExplained(idx); }
+        return true;
+    });
+}
 
-    // Such incrementality does not seem to be beneficial
-    // assertModel();
+void Framework::Expand::expandSequential(Explanations & explanations, Dataset const & data,
+                                         Dataset::SampleIndices const & indices) {
+    initVerifier();
+    initSpeculators();
 
-    Dataset::SampleIndices const indices = makeSampleIndices(data);
+    Print::Writer writer{*framework.printPtr};
     for (auto idx : indices) {
-        // Seems quite more efficient than if outside the loop, at least with 'abductive'
-        assertModel();
+        std::ostringstream cexp;
+        std::ostringstream cstats;
+        SampleStats stats = expandSample(explanations[idx], data, idx, cexp, cstats);
+        writer.submit({.explanation = std::move(cexp).str(),
+                       .stats = std::move(cstats).str(),
+                       .onFlushed = makeRecordCallback(*explanations[idx], idx, std::move(stats))});
+    }
+
+    writer.finish();
+}
+
+void Framework::Expand::expandParallel(Explanations & explanations, Dataset const & data,
+                                       Dataset::SampleIndices const & indices) {
+    std::size_t const size = indices.size();
+    std::size_t const nWorkers = std::min(framework.getConfig().getJobs(), size);
+
+    while (workers.size() < nWorkers) {
+        auto workerPtr = makeWorker();
+        workerPtr->initVerifier();
+        workerPtr->initSpeculators();
+        workers.push_back(std::move(workerPtr));
+    }
+    for (auto & workerPtr : workers) {
+        workerPtr->warmStartPtr = warmStartPtr;
+        workerPtr->explanationCachePtr = explanationCachePtr;
+    }
+
+    // The outputs of the samples are buffered and printed in the order of the indices,
+    // so that the output does not depend on the number of workers
+    struct SampleOutput {
+        std::string explanation{};
+        std::string stats{};
+        SampleStats sampleStats{};
+        bool done{};
+    };
+
+    std::vector<SampleOutput> outputs(size);
+    std::mutex outputsMutex;
+    std::condition_variable outputsCondition;
+    std::atomic<std::size_t> nextPos{};
+    std::exception_ptr exceptionPtr{};
+
+    auto const work = [&](Expand & worker) {
+        while (true) {
+            std::size_t const pos = nextPos++;
+            if (pos >= size) { return; }
+
+            auto const idx = indices[pos];
+            std::ostringstream cexp;
+            std::ostringstream cstats;
+            SampleStats stats;
+            try {
+                stats = worker.expandSample(explanations[idx], data, idx, cexp, cstats);
+            } catch (...) {
+                std::lock_guard lock{outputsMutex};
+                if (not exceptionPtr) { exceptionPtr = std::current_exception(); }
+                // Do not process any further samples
+                nextPos = size;
+                outputsCondition.notify_all();
+                return;
+            }
+
+            std::lock_guard lock{outputsMutex};
+            outputs[pos] = {.explanation = std::move(cexp).str(),
+                            .stats = std::move(cstats).str(),
+                            .sampleStats = std::move(stats),
+                            .done = true};
+            outputsCondition.notify_all();
+        }
+    };
+
+    std::vector<std::jthread> threads;
+    threads.reserve(nWorkers);
+    for (std::size_t i = 0; i < nWorkers; ++i) {
+        threads.emplace_back(work, std::ref(*workers[i]));
+    }
+
+    Print::Writer writer{*framework.printPtr};
+    for (std::size_t pos = 0; pos < size; ++pos) {
+        std::unique_lock lock{outputsMutex};
+        auto & output = outputs[pos];
+        outputsCondition.wait(lock, [&] { return output.done or exceptionPtr; });
+        if (not output.done) { break; }
+
+        Print::Writer::SampleOutput writerOutput{.explanation = std::move(output.explanation),
+                                                 .stats = std::move(output.stats)};
+        SampleStats stats = std::move(output.sampleStats);
+        lock.unlock();
+
+        auto const idx = indices[pos];
+        writerOutput.onFlushed = makeRecordCallback(*explanations[idx], idx, std::move(stats));
+        writer.submit(std::move(writerOutput));
+    }
+
+    threads.clear();
+
+    if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+
+    writer.finish();
+}
+
+std::function<void()> Framework::Expand::makeRecordCallback(Explanation const & explanation,
+                                                            Dataset::Sample::Idx idx, SampleStats stats) {
+    if (not checkpointPtr) { return {}; }
+
+    // Recorded only after the output is flushed, so that a resumed run does not miss the output of any sample
+    return [&checkpoint = *checkpointPtr, &explanation, idx, stats = std::move(stats)] {
+        checkpoint.record(idx, explanation, stats);
+    };
+}
+
+Framework::Expand::SampleStats
+Framework::Expand::expandSample(std::unique_ptr<Explanation> & explanationPtr, Dataset const & data,
+                                Dataset::Sample::Idx idx, std::ostream & cexp, std::ostream & cstats) {
+    Print const & print = *framework.printPtr;
+    bool const printingStats = not print.ignoringStats();
+    bool const printingExplanations = not print.ignoringExplanations();
 
-        auto const & output = data.getComputedOutput(idx);
-        assertClassification(output);
+    Trace::Scope traceScope{framework.tracePtr.get(), "sample", "expand"};
+    traceScope.addArg("sample", idx + 1);
 
-        auto & explanationPtr = explanations[idx];
-        for (auto & strategy : strategies) {
-            strategy->execute(explanationPtr);
+    std::optional<ExplanationCache::Key> optCacheKey;
+    std::optional<ExplanationCache::Entry> optCacheEntry;
+    if (explanationCachePtr) {
+        optCacheKey = explanationCachePtr->tryMakeKey(*explanationPtr, data.getSample(idx));
+        if (optCacheKey) { optCacheEntry = explanationCachePtr->load(*optCacheKey); }
+    }
+
+    bool const cached = bool(optCacheEntry);
+    if (cached) {
+        explanationPtr = std::move(optCacheEntry->explanationPtr);
+        sampleStats = optCacheEntry->stats;
+    } else {
+        expandSampleWithStrategies(explanationPtr, data, idx);
+        // A truncated explanation could be improved with larger budgets
+        if (optCacheKey and not sampleStats.truncated) {
+            explanationCachePtr->store(*optCacheKey, *explanationPtr, sampleStats);
         }
+    }
+    if (warmStartPtr) { warmStartPtr->markExplained(idx); }
+
+    traceScope.addArg("checks", sampleStats.checks);
+    if (sampleStats.cached) { traceScope.addArg("cached", "yes"); }
+    if (sampleStats.truncated) { traceScope.addArg("truncated", "yes"); }
 
-        //+ get rid of the conditionals
-        auto & explanation = *explanationPtr;
-        if (printingStats) { printStats(explanation, data, idx); }
-        if (printingExplanations) {
+    //+ get rid of the conditionals
+    auto & explanation = *explanationPtr;
+    if (printingStats) { printStats(cstats, explanation, data, idx); }
+    if (printingExplanations) {
+        if (not framework.getConfig().printingIntervalExplanationsInBinaryFormat()) {
             explanation.print(cexp);
-            cexp << std::endl;
+            cexp << '\n';
+        } else if (auto * iexplanationPtr = dynamic_cast<IntervalExplanation const *>(&explanation)) {
+            // The binary records are not delimited
+            iexplanationPtr->printBinary(cexp);
+        } else {
+            throw std::logic_error{"The binary format supports only interval explanations"};
+        }
+    }
+
+    // Only after the printing, as e.g. the formula explanations refer to the terms of the verifier
+    if (not cached) { resetSampleConstraints(); }
+
+    return std::exchange(sampleStats, {});
+}
+
+void Framework::Expand::expandSampleWithStrategies(std::unique_ptr<Explanation> & explanationPtr, Dataset const & data,
+                                                   Dataset::Sample::Idx idx) {
+    bool const persistentModel = framework.getConfig().usingPersistentModel();
+
+    sampleStartTime = std::chrono::steady_clock::now();
+    for (auto & speculatorPtr : speculators) {
+        speculatorPtr->sampleStartTime = sampleStartTime;
+    }
+
+    auto const & output = data.getComputedOutput(idx);
+    if (not usingOwnVerifier()) {
+        // The portfolio only needs the output to pass it to its racers
+        classificationOutputPtr = &output;
+        executeStrategies(explanationPtr);
+        classificationOutputPtr = nullptr;
+        return;
+    }
+
+    // Seems quite more efficient than if outside the loop, at least with 'abductive'
+    // For easy samples however, the encoding of the model may cost more than the checks themselves
+    if (not persistentModel) { assertModel(); }
+
+    assertClassification(output);
+
+    runInParallel(speculators.size(), [&](std::size_t i) {
+        auto & speculator = *speculators[i];
+        if (not persistentModel) { speculator.assertModel(); }
+        speculator.assertClassification(output);
+    });
+
+    if (warmStartPtr) { warmStart(explanationPtr, data, idx); }
+
+    executeStrategies(explanationPtr);
+
+    // The strategies may have added the checks of other verifiers
+    sampleStats.checks += verifierPtr->getChecksCount();
+}
+
+void Framework::Expand::resetSampleConstraints() {
+    // Nothing was asserted to the verifiers
+    if (not usingOwnVerifier()) { return; }
+
+    bool const persistentModel = framework.getConfig().usingPersistentModel();
+
+    resetClassification();
+
+    if (not persistentModel) { resetModel(); }
+
+    for (auto & speculatorPtr : speculators) {
+        speculatorPtr->resetClassification();
+        if (not persistentModel) { speculatorPtr->resetModel(); }
+        speculatorPtr->sampleStats = {};
+    }
+}
+
+void Framework::Expand::executeStrategies(std::unique_ptr<Explanation> & explanationPtr) {
+    for (auto & strategy : strategies) {
+        Trace::Scope traceScope{framework.tracePtr.get(), strategy->getName(), "strategy"};
+        strategy->execute(explanationPtr);
+    }
+}
+
+void Framework::Expand::warmStart(std::unique_ptr<Explanation> & explanationPtr, Dataset const & data,
+                                  Dataset::Sample::Idx idx) {
+    assert(warmStartPtr);
+    std::size_t const varSize = framework.varSize();
+    // Only the initial point explanations are replaced
+    if (explanationPtr->varSize() < varSize) { return; }
+
+    auto const optNeighborIdx = warmStartPtr->findExplainedNeighbor(idx);
+    if (not optNeighborIdx) { return; }
+    auto const * neighborIexplanationPtr =
+        dynamic_cast<IntervalExplanation const *>(&warmStartPtr->getExplanation(*optNeighborIdx));
+    if (not neighborIexplanationPtr) { return; }
+    auto const & neighborIexplanation = *neighborIexplanationPtr;
+
+    // The bounds of the neighbor that do not contain the sample are replaced by the values of the sample,
+    // hence the candidate always contains the sample
+    auto const sample = data.getSample(idx);
+    auto candidatePtr = std::make_unique<IntervalExplanation>(framework);
+    auto & candidate = *candidatePtr;
+    InputBox box;
+    box.lower.reserve(varSize);
+    box.upper.reserve(varSize);
+    for (VarIdx i = 0; i < varSize; ++i) {
+        Interval ival = framework.getDomainInterval(i);
+        if (auto * optVarBnd = neighborIexplanation.tryGetVarBound(i)) {
+            ival = optVarBnd->toInterval();
+            Float const val = sample[i];
+            if (val < ival.getLower() or val > ival.getUpper()) { ival = Interval{val}; }
+            candidate[i] = intervalToOptVarBound(framework, i, ival);
         }
+        box.lower.push_back(ival.getLower());
+        box.upper.push_back(ival.getUpper());
+    }
+
+    // A single check of the whole candidate
+    bool ok = not (counterexampleCachePtr and counterexampleCacheContainsPointIn(box));
+    if (ok and not (framework.getConfig().usingBoundPropagation() and boundPropagationProvesClassification(box))) {
+        ok = checkBoxFormsExplanation(box);
+    }
+    if (not ok) { return; }
 
-        resetClassification();
+    explanationPtr = std::move(candidatePtr);
+    sampleStats.warmStartNeighbor = *optNeighborIdx;
+}
+
+std::string Framework::Expand::makeExplanationsContext() const {
+    auto const & config = framework.getConfig();
+    // Everything the explanations depend on, apart from the model, the samples and the starting explanations
+    std::ostringstream contextOss;
+    contextOss << "strategies: " << strategiesSpec << '\n';
+    contextOss << "verifier: " << verifierName << '\n';
+    contextOss << "reverse var ordering: " << config.isReverseVarOrdering() << '\n';
+    contextOss << "warm start: " << config.usingWarmStart() << '\n';
+    return std::move(contextOss).str();
+}
 
-        resetModel();
+std::string Framework::Expand::makeCheckpointContext() const {
+    auto const & config = framework.getConfig();
+    // Moreover the selection and the order of the samples
+    std::ostringstream contextOss;
+    contextOss << makeExplanationsContext();
+    contextOss << "filter correct: " << config.filteringCorrectSamples() << '\n';
+    contextOss << "filter incorrect: " << config.filteringIncorrectSamples() << '\n';
+    if (config.filteringSamplesOfExpectedClass()) {
+        contextOss << "filter expected class: " << config.getSamplesExpectedClassFilter().label << '\n';
     }
+    contextOss << "shuffle: " << config.shufflingSamples() << '\n';
+    contextOss << "max samples: " << config.getMaxSamples() << '\n';
+    return std::move(contextOss).str();
+}
+
+void Framework::Expand::initExplanationCache() {
+    auto const & config = framework.getConfig();
+    explanationCachePtr =
+        std::make_shared<ExplanationCache>(framework, config.getExplanationCacheDir(), makeExplanationsContext());
+}
+
+bool Framework::Expand::usingOwnVerifier() const {
+    // The warm start checks its candidates on the verifier of this
+    if (framework.getConfig().usingWarmStart()) { return true; }
+    if (strategies.size() != 1) { return true; }
+    return not dynamic_cast<PortfolioStrategy const *>(strategies.front().get());
 }
 
 void Framework::Expand::initVerifier() {
     assert(verifierPtr);
+    // The verifier stays initialized across the expansions, e.g. of the requests of the server,
+    // including the persistent model
+    if (verifierInitialized) { return; }
+    verifierInitialized = true;
+
     verifierPtr->init();
+
+    if (framework.tracePtr) { verifierPtr->setTracer(framework.tracePtr.get()); }
+
+    if (requiresInputModels) { verifierPtr->produceInputModels(); }
+    if (framework.getConfig().usingCounterexampleCache()) {
+        verifierPtr->produceInputModels();
+        counterexampleCachePtr = std::make_unique<CounterexampleCache>(framework.varSize());
+    }
+
+    // The model is encoded at the base level and each sample only pushes and pops its own constraints
+    if (framework.getConfig().usingPersistentModel() and usingOwnVerifier()) { assertModel(); }
+}
+
+void Framework::Expand::initSpeculators() {
+    auto const & config = framework.getConfig();
+    if (not config.speculating() or not usingOwnVerifier()) { return; }
+
+    std::size_t const nSpeculators = config.getSpeculativeJobs();
+    while (speculators.size() < nSpeculators) {
+        speculators.push_back(makeWorker());
+    }
+
+    runInParallel(nSpeculators, [&](std::size_t i) { speculators[i]->initVerifier(); });
 }
 
 void Framework::Expand::assertModel() {
@@ -178,6 +623,7 @@ void Framework::Expand::resetModel() {
 
 void Framework::Expand::assertClassification(Dataset::Output const & output) {
     verifierPtr->push();
+    classificationOutputPtr = &output;
 
     auto & network = framework.getNetwork();
     auto const outputLayerIndex = network.getNumLayers() - 1;
@@ -192,7 +638,7 @@ void Framework::Expand::assertClassification(Dataset::Output const & output) {
     }
 
     // With single output value, the flip in classification means flipping the value across 0
-    constexpr Float threshold = 0.015625f;
+    constexpr Float threshold = binaryClassificationThreshold;
     [[maybe_unused]] Float const val = outputValues.front();
     assert(Preprocess::computeBinaryClassificationLabel(outputValues) == label);
     assert(label == 0 || label == 1);
@@ -210,6 +656,175 @@ void Framework::Expand::assertClassification(Dataset::Output const & output) {
 void Framework::Expand::resetClassification() {
     verifierPtr->pop();
     verifierPtr->resetSample();
+    classificationOutputPtr = nullptr;
+    if (counterexampleCachePtr) { counterexampleCachePtr->clear(); }
+}
+
+bool Framework::Expand::boundPropagationProvesClassification(InputBox const & box) {
+    assert(classificationOutputPtr);
+
+    auto & network = framework.getNetwork();
+    if (not boundPropagationPtr) { boundPropagationPtr = std::make_unique<xai::nn::IntervalBoundPropagation>(network); }
+    auto & boundPropagation = *boundPropagationPtr;
+
+    boundPropagation.propagate(box.lower, box.upper);
+
+    // Must be consistent with the constraints of assertClassification
+    auto const label = classificationOutputPtr->classificationLabel;
+    auto const & outputValues = classificationOutputPtr->values;
+    if (not Preprocess::isBinaryClassification(outputValues)) {
+        std::size_t const outputSize = outputValues.size();
+        for (std::size_t node = 0; node < outputSize; ++node) {
+            if (node == label) { continue; }
+            if (boundPropagation.getOutputDifferenceUpperBound(node, label) > 0) { return false; }
+        }
+        return true;
+    }
+
+    constexpr Float threshold = binaryClassificationThreshold;
+    if (label == 1) {
+        return boundPropagation.getOutputLowerBound(0) > -threshold;
+    } else {
+        return boundPropagation.getOutputUpperBound(0) < threshold;
+    }
+}
+
+bool Framework::Expand::checkBoxFormsExplanation(InputBox const & box) {
+    auto & network = framework.getNetwork();
+    std::size_t const varSize = framework.varSize();
+    assert(box.lower.size() == varSize);
+    assert(box.upper.size() == varSize);
+
+    verifierPtr->push();
+    for (VarIdx idx = 0; idx < varSize; ++idx) {
+        Float const lo = box.lower[idx];
+        Float const hi = box.upper[idx];
+        if (lo == hi) {
+            verifierPtr->addEquality(0, idx, lo);
+            continue;
+        }
+        if (lo > network.getInputLowerBound(idx)) { verifierPtr->addLowerBound(0, idx, lo); }
+        if (hi < network.getInputUpperBound(idx)) { verifierPtr->addUpperBound(0, idx, hi); }
+    }
+    auto const answer = applyCheckBudget() ? verifierPtr->check() : xai::verifiers::Verifier::Answer::UNKNOWN;
+    verifierPtr->pop();
+
+    // UNKNOWN is possible with incomplete verifiers and must be treated as not proven
+    assert(answer != xai::verifiers::Verifier::Answer::ERROR);
+    if (answer == xai::verifiers::Verifier::Answer::UNKNOWN) { noteUnknownAnswer(); }
+    return (answer == xai::verifiers::Verifier::Answer::UNSAT);
+}
+
+std::vector<bool> Framework::Expand::checkBoxesFormExplanationSpeculatively(std::span<InputBox const> boxes) {
+    std::size_t const size = boxes.size();
+    assert(size <= speculators.size());
+
+    // std::vector<bool> cannot be written concurrently
+    std::vector<char> results(size);
+    runInParallel(size, [&](std::size_t i) { results[i] = speculators[i]->checkBoxFormsExplanation(boxes[i]); });
+    sampleStats.speculativeChecks += size;
+    for (std::size_t i = 0; i < size; ++i) {
+        if (speculators[i]->sampleStats.truncated) { sampleStats.truncated = true; }
+    }
+
+    if (counterexampleCachePtr) {
+        for (std::size_t i = 0; i < size; ++i) {
+            if (not results[i]) { recordCounterexample(speculators[i]->getVerifier().getInputModel()); }
+        }
+    }
+
+    return {results.begin(), results.end()};
+}
+
+bool Framework::Expand::applyCheckBudget() {
+    if (stopToken.stop_requested()) {
+        sampleStats.truncated = true;
+        return false;
+    }
+
+    auto const & config = framework.getConfig();
+    if (not config.usingBudgets() and not stopToken.stop_possible()) { return true; }
+
+    xai::verifiers::Verifier::Budget budget{.timeout = config.getCheckTimeout(),
+                                            .conflicts = config.getCheckConflictLimit(),
+                                            .stopToken = stopToken};
+
+    if (double const sampleTimeout = config.getSampleTimeout(); sampleTimeout > 0) {
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - sampleStartTime;
+        double const remaining = sampleTimeout - elapsed.count();
+        if (remaining <= 0) {
+            sampleStats.truncated = true;
+            return false;
+        }
+        if (budget.timeout == 0 or remaining < budget.timeout) { budget.timeout = remaining; }
+    }
+
+    if (std::size_t const sampleConflictLimit = config.getSampleConflictLimit(); sampleConflictLimit > 0) {
+        std::size_t const used = verifierPtr->getConflictsCount();
+        if (used >= sampleConflictLimit) {
+            sampleStats.truncated = true;
+            return false;
+        }
+        std::size_t const remaining = sampleConflictLimit - used;
+        if (budget.conflicts == 0 or remaining < budget.conflicts) { budget.conflicts = remaining; }
+    }
+
+    verifierPtr->setCheckBudget(budget);
+    return true;
+}
+
+void Framework::Expand::noteUnknownAnswer() {
+    if (verifierPtr->lastCheckInterrupted() or stopToken.stop_requested()) { sampleStats.truncated = true; }
+}
+
+void Framework::Expand::recordCounterexample() {
+    recordCounterexample(verifierPtr->getInputModel());
+}
+
+void Framework::Expand::recordCounterexample(std::vector<float> const & model) {
+    assert(counterexampleCachePtr);
+    if (model.empty()) { return; }
+
+    // The model may be slightly off after the conversion to floats,
+    // hence it is only stored if it is a concrete counterexample
+    auto const outputValues = xai::nn::computeOutput(model, framework.getNetwork());
+    if (not outputViolatesClassification(outputValues)) { return; }
+
+    counterexampleCachePtr->insert(model);
+}
+
+bool Framework::Expand::counterexampleCacheContainsPointIn(InputBox const & box) const {
+    assert(counterexampleCachePtr);
+    return counterexampleCachePtr->containsPointIn(box);
+}
+
+bool Framework::Expand::outputViolatesClassification(Dataset::Output::Values const & values) const {
+    assert(classificationOutputPtr);
+
+    auto const label = classificationOutputPtr->classificationLabel;
+    assert(values.size() == classificationOutputPtr->values.size());
+    Float maxMagnitude = 1;
+    for (Float val : values) {
+        maxMagnitude = std::max(maxMagnitude, std::abs(val));
+    }
+    Float const margin = counterexampleMargin * maxMagnitude;
+
+    if (not Preprocess::isBinaryClassification(values)) {
+        std::size_t const outputSize = values.size();
+        for (std::size_t node = 0; node < outputSize; ++node) {
+            if (node == label) { continue; }
+            if (values[node] - values[label] > margin) { return true; }
+        }
+        return false;
+    }
+
+    constexpr Float threshold = binaryClassificationThreshold;
+    Float const val = values.front();
+    if (label == 1) {
+        return val <= -threshold - margin;
+    } else {
+        return val >= threshold + margin;
+    }
 }
 
 void Framework::Expand::printStatsHead(Dataset const & data) const {
@@ -231,11 +846,9 @@ void Framework::Expand::printStatsHead(Dataset const & data) const {
     cstats << std::string(60, '-') << '\n';
 }
 
-void Framework::Expand::printStats(Explanation const & explanation, Dataset const & data,
+void Framework::Expand::printStats(std::ostream & cstats, Explanation const & explanation, Dataset const & data,
                                    Dataset::Sample::Idx idx) const {
-    Print const & print = *framework.printPtr;
-    assert(not print.ignoringStats());
-    auto & cstats = print.stats();
+    assert(not framework.printPtr->ignoringStats());
     auto const defaultPrecision = cstats.precision();
 
     std::size_t const varSize = framework.varSize();
@@ -257,8 +870,23 @@ void Framework::Expand::printStats(Explanation const & explanation, Dataset cons
     cstats << "sample [" << idx + 1 << '/' << dataSize << "]: " << sample << '\n';
     cstats << "expected output: " << expClass << '\n';
     cstats << "computed output: " << compClass << '\n';
-    cstats << "#checks: " << verifierPtr->getChecksCount() << '\n';
-    cstats << "#features: " << expVarSize << '/' << varSize << std::endl;
+    if (sampleStats.warmStartNeighbor) {
+        cstats << "warm start from sample: " << *sampleStats.warmStartNeighbor + 1 << '\n';
+    }
+    if (sampleStats.cached) { cstats << "cached: yes\n"; }
+    if (sampleStats.truncated) { cstats << "truncated: yes\n"; }
+    cstats << "#checks: " << sampleStats.checks << '\n';
+    if (framework.getConfig().usingBoundPropagation()) {
+        cstats << "#skipped checks: " << sampleStats.skippedChecks << '\n';
+    }
+    if (framework.getConfig().usingCounterexampleCache()) {
+        cstats << "#cached checks: " << sampleStats.cachedChecks << '\n';
+    }
+    if (framework.getConfig().speculating()) {
+        cstats << "#speculative checks: " << sampleStats.speculativeChecks << '\n';
+        cstats << "#discarded checks: " << sampleStats.discardedChecks << '\n';
+    }
+    cstats << "#features: " << expVarSize << '/' << varSize << '\n';
 
     assert(not explanation.supportsVolume() or explanation.getRelativeVolumeSkipFixed() > 0);
     assert(explanation.getRelativeVolumeSkipFixed() <= 1);
@@ -273,13 +901,13 @@ void Framework::Expand::printStats(Explanation const & explanation, Dataset cons
     }
 
     cstats << "#fixed features: " << fixedCount << '/' << varSize << '\n';
-    cstats << "#terms: " << termSize << std::endl;
+    cstats << "#terms: " << termSize << '\n';
 
     if (not explanation.supportsVolume()) { return; }
 
     Float const relVolume = explanation.getRelativeVolumeSkipFixed();
 
     cstats << "relVolume*: " << std::setprecision(1) << (relVolume * 100) << "%" << std::setprecision(defaultPrecision)
-           << std::endl;
+           << '\n';
 }
 } // namespace xspace
@@ -6,9 +6,20 @@
 #include <xspace/common/Var.h>
 #include <xspace/nn/Dataset.h>
 
+#include <chrono>
+#include <functional>
+#include <iosfwd>
 #include <memory>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
 #include <vector>
 
+namespace xai::nn {
+class IntervalBoundPropagation;
+}
+
 namespace xai::verifiers {
 class Verifier;
 }
@@ -25,14 +36,26 @@ public:
         std::vector<VarIdx> order{};
     };
 
+    struct InputBox {
+        std::vector<Float> lower{};
+        std::vector<Float> upper{};
+    };
+
+    class CounterexampleCache;
+    class ExplanationCache;
+    class Checkpoint;
+    class WarmStart;
+
     class Strategy;
     class AbductiveStrategy;
     class TrialAndErrorStrategy;
     class UnsatCoreStrategy;
+    class PortfolioStrategy;
 
     using Strategies = std::vector<std::unique_ptr<Strategy>>;
 
     Expand(Framework &);
+    ~Expand();
 
     Framework const & getFramework() const { return framework; }
 
@@ -51,12 +74,59 @@ public:
 protected:
     void addStrategy(std::unique_ptr<Strategy>);
 
+    // A worker has its own verifier and its own copy of the strategies
+    std::unique_ptr<Expand> makeWorker() const;
+    std::unique_ptr<Expand> makeWorker(std::string const & spec, std::string_view vfName) const;
+
     std::unique_ptr<xai::verifiers::Verifier> makeVerifier(std::string_view name) const;
     void setVerifier(std::unique_ptr<xai::verifiers::Verifier>);
 
     Dataset::SampleIndices makeSampleIndices(Dataset const &) const;
 
+    void expandSequential(Explanations &, Dataset const &, Dataset::SampleIndices const &);
+    void expandParallel(Explanations &, Dataset const &, Dataset::SampleIndices const &);
+
+    // Removes the samples that are already completed in the checkpoint and restores their explanations
+    void skipCompletedSamples(Explanations &, Dataset::SampleIndices &);
+
+    struct SampleStats;
+    SampleStats expandSample(std::unique_ptr<Explanation> &, Dataset const &, Dataset::Sample::Idx,
+                             std::ostream & cexp, std::ostream & cstats);
+
+    // Returns the callback that records the sample in the checkpoint, if any
+    std::function<void()> makeRecordCallback(Explanation const &, Dataset::Sample::Idx, SampleStats);
+    // Without the explanation cache and the printing
+    // The constraints of the sample stay asserted until resetSampleConstraints
+    void expandSampleWithStrategies(std::unique_ptr<Explanation> &, Dataset const &, Dataset::Sample::Idx);
+    void resetSampleConstraints();
+    // Assumes that the model and the classification are asserted
+    void executeStrategies(std::unique_ptr<Explanation> &);
+
+    // Replaces the point explanation with the explanation of an already explained neighbor if it is valid here too
+    void warmStart(std::unique_ptr<Explanation> &, Dataset const &, Dataset::Sample::Idx);
+
+    // What the explanations depend on apart from the model, the samples and the starting explanations
+    std::string makeExplanationsContext() const;
+    // Moreover what determines the samples to be explained and their order
+    std::string makeCheckpointContext() const;
+
+    void initExplanationCache();
+
+    // Limits the next check of the verifier by the per-check budget and by the rest of the per-sample budget
+    // Returns false if the per-sample budget is already exhausted or a stop was requested,
+    // then the check must not be run
+    bool applyCheckBudget();
+    // An UNKNOWN answer caused by the budgets or by a stop means the sample is not fully explained,
+    // unlike an UNKNOWN answer of an incomplete verifier
+    void noteUnknownAnswer();
+
+    // False if the only strategy is a portfolio, which races its chains on the verifiers of its own workers,
+    // and nothing else checks the samples on the verifier of this
+    bool usingOwnVerifier() const;
+
     void initVerifier();
+    // Each speculator has its own verifier to check candidate explanations in parallel within a sample
+    void initSpeculators();
 
     void assertModel();
     void resetModel();
@@ -64,16 +134,78 @@ protected:
     void assertClassification(Dataset::Output const &);
     void resetClassification();
 
+    // Sound but incomplete, does not involve the verifier
+    bool boundPropagationProvesClassification(InputBox const &);
+
+    // Checks the box independently of what the strategies have asserted to the verifier
+    bool checkBoxFormsExplanation(InputBox const &);
+    // Each box is checked by a different speculator, all in parallel
+    std::vector<bool> checkBoxesFormExplanationSpeculatively(std::span<InputBox const>);
+
+    // Stores the input model of the last check if it is a concrete counterexample of the classification
+    void recordCounterexample();
+    void recordCounterexample(std::vector<float> const & model);
+    bool counterexampleCacheContainsPointIn(InputBox const &) const;
+
+    // Must be consistent with the constraints of assertClassification, up to a margin for rounding errors
+    bool outputViolatesClassification(Dataset::Output::Values const &) const;
+
     void printStatsHead(Dataset const &) const;
-    void printStats(Explanation const &, Dataset const &, Dataset::Sample::Idx) const;
+    void printStats(std::ostream &, Explanation const &, Dataset const &, Dataset::Sample::Idx) const;
 
     Framework & framework;
 
+    // Per-sample statistics that are not tracked by the verifier
+    struct SampleStats {
+        // Of the verifier, which resets it with each sample
+        std::size_t checks{};
+        std::size_t skippedChecks{};
+        std::size_t cachedChecks{};
+        std::size_t speculativeChecks{};
+        // Speculative results that were invalidated by an earlier result
+        std::size_t discardedChecks{};
+        std::optional<Dataset::Sample::Idx> warmStartNeighbor{};
+        // Loaded from the explanation cache
+        bool cached{};
+        // Some checks did not finish within the budgets, the explanation is valid but not necessarily minimal
+        bool truncated{};
+    };
+
+    static constexpr Float binaryClassificationThreshold = 0.015625f;
+    // Relative to the magnitude of the output values
+    static constexpr Float counterexampleMargin = 1e-4f;
+
     std::unique_ptr<xai::verifiers::Verifier> verifierPtr{};
+    bool verifierInitialized{false};
+
+    std::chrono::steady_clock::time_point sampleStartTime{};
+    // Set for the racers of a portfolio, which are stopped once they cannot win anymore
+    std::stop_token stopToken{};
+
+    std::unique_ptr<xai::nn::IntervalBoundPropagation> boundPropagationPtr{};
+    Dataset::Output const * classificationOutputPtr{};
+
+    std::unique_ptr<CounterexampleCache> counterexampleCachePtr{};
+
+    std::shared_ptr<WarmStart> warmStartPtr{};
+
+    std::shared_ptr<ExplanationCache> explanationCachePtr{};
+
+    std::unique_ptr<Checkpoint> checkpointPtr{};
+
+    SampleStats sampleStats{};
 
     Strategies strategies{};
 
+    // Kept to be able to construct the workers
+    std::string strategiesSpec{};
+    std::string verifierName{};
+
+    std::vector<std::unique_ptr<Expand>> workers{};
+    std::vector<std::unique_ptr<Expand>> speculators{};
+
     bool requiresSMTSolver{false};
+    bool requiresInputModels{false};
 
 private:
     Dataset::SampleIndices getSampleIndices(Dataset const &) const;
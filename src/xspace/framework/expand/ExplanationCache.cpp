@@ -0,0 +1,225 @@
+#include "ExplanationCache.h"
+
+#include "../explanation/IntervalExplanation.h"
+#include "../explanation/VarBound.h"
+
+#include <bit>
+#include <cassert>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <unistd.h>
+
+namespace xspace {
+namespace {
+constexpr std::string_view header = "xspace explanation cache 1";
+constexpr std::string_view boundsEnd = "end";
+
+// Exact round-trip of the values
+void writeFloat(std::ostream & os, Float val) {
+    char buf[32];
+    auto const [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), val, std::chars_format::hex);
+    assert(ec == std::errc{});
+    os << std::string_view{buf, ptr};
+}
+
+Float readFloat(std::istream & is) {
+    std::string str;
+    is >> str;
+    Float val;
+    auto const [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), val, std::chars_format::hex);
+    if (ec != std::errc{} or ptr != str.data() + str.size()) {
+        throw std::invalid_argument{"Invalid value in the explanation cache: "s + str};
+    }
+    return val;
+}
+} // namespace
+
+void Framework::Expand::ExplanationCache::Hash::update(std::span<std::byte const> bytes) {
+    for (std::byte byte : bytes) {
+        auto const val = std::to_integer<std::uint64_t>(byte);
+        fnv = (fnv ^ val) * 0x100000001b3;
+        mult = std::rotl((mult ^ val) * 0xff51afd7ed558ccd, 23);
+    }
+}
+
+std::string Framework::Expand::ExplanationCache::Hash::toHex() const {
+    char buf[33];
+    std::snprintf(buf, sizeof(buf), "%016llx%016llx", static_cast<unsigned long long>(fnv),
+                  static_cast<unsigned long long>(mult));
+    return buf;
+}
+
+Framework::Expand::ExplanationCache::ExplanationCache(Framework const & fw, std::string_view dirName,
+                                                      std::string_view context)
+    : framework{fw},
+      dirPath{dirName} {
+    std::filesystem::create_directories(dirPath);
+
+    baseHash.update(header);
+    baseHash.update(context);
+
+    hashNetwork(baseHash, framework.getNetwork());
+}
+
+void Framework::Expand::ExplanationCache::hashNetwork(Hash & hash, xai::nn::NNet const & network) {
+    std::size_t const numLayers = network.getNumLayers();
+    for (std::size_t layer = 0; layer < numLayers; ++layer) {
+        std::size_t const layerSize = network.getLayerSize(layer);
+        hash.update(std::as_bytes(std::span{&layerSize, 1}));
+        if (layer == 0) { continue; }
+        for (std::size_t node = 0; node < layerSize; ++node) {
+            hash.update(network.getWeights(layer, node));
+        }
+        hash.update(network.getBiases(layer));
+    }
+    for (std::size_t node = 0; node < network.getInputSize(); ++node) {
+        Float const bounds[] = {network.getInputLowerBound(node), network.getInputUpperBound(node)};
+        hash.update(std::span<Float const>{bounds});
+    }
+}
+
+std::optional<Framework::Expand::ExplanationCache::Key>
+Framework::Expand::ExplanationCache::tryMakeKey(Explanation const & startingExplanation,
+                                                Dataset::Sample const & sample) const {
+    auto const * iexplanationPtr = dynamic_cast<IntervalExplanation const *>(&startingExplanation);
+    if (not iexplanationPtr) { return std::nullopt; }
+
+    Hash hash = baseHash;
+    hash.update(sample);
+    std::ostringstream oss;
+    writeBounds(oss, *iexplanationPtr);
+    hash.update(std::move(oss).str());
+    return hash.toHex();
+}
+
+std::optional<Framework::Expand::ExplanationCache::Entry>
+Framework::Expand::ExplanationCache::load(Key const & key) const {
+    std::ifstream ifs{getPath(key)};
+    if (not ifs) { return std::nullopt; }
+
+    std::string line;
+    if (not std::getline(ifs, line) or line != header) {
+        throw std::invalid_argument{"Invalid header of the explanation cache entry: "s + getPath(key).string()};
+    }
+
+    Entry entry = readEntry(framework, ifs);
+    entry.stats.cached = true;
+    return entry;
+}
+
+void Framework::Expand::ExplanationCache::store(Key const & key, Explanation const & explanation,
+                                                SampleStats const & stats) const {
+    auto const * iexplanationPtr = dynamic_cast<IntervalExplanation const *>(&explanation);
+    if (not iexplanationPtr) { return; }
+
+    // Written to a unique temporary file first so that concurrent readers never see a partial entry
+    auto const path = getPath(key);
+    auto tmpPath = path;
+    tmpPath += ".tmp." + std::to_string(::getpid()) + '.' +
+               std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream ofs{tmpPath};
+        if (not ofs) { throw std::runtime_error{"Could not write the explanation cache entry: "s + tmpPath.string()}; }
+        ofs << header << '\n';
+        writeEntry(ofs, *iexplanationPtr, stats);
+    }
+    std::filesystem::rename(tmpPath, path);
+}
+
+void Framework::Expand::ExplanationCache::writeEntry(std::ostream & os, IntervalExplanation const & iexplanation,
+                                                     SampleStats const & stats) {
+    writeBounds(os, iexplanation);
+    os << "checks " << stats.checks << '\n';
+    os << "skippedChecks " << stats.skippedChecks << '\n';
+    os << "cachedChecks " << stats.cachedChecks << '\n';
+    os << "speculativeChecks " << stats.speculativeChecks << '\n';
+    os << "discardedChecks " << stats.discardedChecks << '\n';
+    os << "truncated " << stats.truncated << '\n';
+}
+
+Framework::Expand::ExplanationCache::Entry Framework::Expand::ExplanationCache::readEntry(Framework const & fw,
+                                                                                         std::istream & is) {
+    Entry entry{.explanationPtr = readBounds(fw, is), .stats = {}};
+    auto & stats = entry.stats;
+    std::string name;
+    std::size_t val;
+    while (is >> name >> val) {
+        if (name == "checks") {
+            stats.checks = val;
+        } else if (name == "skippedChecks") {
+            stats.skippedChecks = val;
+        } else if (name == "cachedChecks") {
+            stats.cachedChecks = val;
+        } else if (name == "speculativeChecks") {
+            stats.speculativeChecks = val;
+        } else if (name == "discardedChecks") {
+            stats.discardedChecks = val;
+        } else if (name == "truncated") {
+            stats.truncated = val;
+        }
+    }
+
+    return entry;
+}
+
+void Framework::Expand::ExplanationCache::writeBounds(std::ostream & os, IntervalExplanation const & iexplanation) {
+    std::size_t const size = iexplanation.size();
+    for (VarIdx idx = 0; idx < size; ++idx) {
+        auto * optVarBnd = iexplanation.tryGetVarBound(idx);
+        if (not optVarBnd) { continue; }
+        auto & varBnd = *optVarBnd;
+
+        os << idx << ' ';
+        if (varBnd.isInterval()) {
+            os << "[] ";
+            writeFloat(os, varBnd.getIntervalLower().getValue());
+            os << ' ';
+            writeFloat(os, varBnd.getIntervalUpper().getValue());
+        } else {
+            auto & bnd = varBnd.getBound();
+            os << (bnd.isEq() ? "= " : bnd.isLower() ? ">= " : "<= ");
+            writeFloat(os, bnd.getValue());
+        }
+        os << '\n';
+    }
+    os << boundsEnd << '\n';
+}
+
+std::unique_ptr<IntervalExplanation> Framework::Expand::ExplanationCache::readBounds(Framework const & framework,
+                                                                                     std::istream & is) {
+    auto iexplanationPtr = std::make_unique<IntervalExplanation>(framework);
+    auto & iexplanation = *iexplanationPtr;
+    std::string token;
+    while (is >> token) {
+        if (token == boundsEnd) { return iexplanationPtr; }
+
+        VarIdx const idx = std::stoull(token);
+        if (idx >= framework.varSize()) {
+            throw std::invalid_argument{"Invalid variable in the explanation cache: "s + token};
+        }
+        std::string op;
+        is >> op;
+        if (op == "[]") {
+            Float const lo = readFloat(is);
+            Float const hi = readFloat(is);
+            iexplanation.insertVarBound(VarBound{framework, idx, LowerBound{lo}, UpperBound{hi}});
+        } else if (op == "=") {
+            iexplanation.insertVarBound(VarBound{framework, idx, EqBound{readFloat(is)}});
+        } else if (op == ">=") {
+            iexplanation.insertVarBound(VarBound{framework, idx, LowerBound{readFloat(is)}});
+        } else if (op == "<=") {
+            iexplanation.insertVarBound(VarBound{framework, idx, UpperBound{readFloat(is)}});
+        } else {
+            throw std::invalid_argument{"Invalid bound in the explanation cache: "s + op};
+        }
+    }
+
+    throw std::invalid_argument{"Unterminated bounds in the explanation cache"s};
+}
+} // namespace xspace
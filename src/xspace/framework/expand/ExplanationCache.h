@@ -0,0 +1,74 @@
+#ifndef XSPACE_EXPAND_EXPLANATIONCACHE_H
+#define XSPACE_EXPAND_EXPLANATIONCACHE_H
+
+#include "Expand.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace xspace {
+class IntervalExplanation;
+
+// Persistent cache of the finished explanations and their stats, with one file per entry in a directory
+// The key is a hash of the model, the strategies spec, the verifier, the var ordering,
+// and of the sample together with its starting explanation
+// Only interval explanations are supported
+// Can be shared by multiple workers and processes
+class Framework::Expand::ExplanationCache {
+public:
+    using Key = std::string;
+
+    // 128 bits in two lanes: FNV-1a and a multiplicative hash with rotations
+    struct Hash {
+        std::uint64_t fnv = 0xcbf29ce484222325;
+        std::uint64_t mult = 0x9e3779b97f4a7c15;
+
+        void update(std::span<std::byte const>);
+        void update(std::string_view str) { update(std::as_bytes(std::span{str})); }
+        void update(std::span<Float const> values) { update(std::as_bytes(values)); }
+
+        std::string toHex() const;
+    };
+
+    struct Entry {
+        std::unique_ptr<IntervalExplanation> explanationPtr;
+        SampleStats stats;
+    };
+
+    // The context covers what the results depend on apart from the model and the samples
+    ExplanationCache(Framework const &, std::string_view dirName, std::string_view context);
+
+    std::optional<Key> tryMakeKey(Explanation const & startingExplanation, Dataset::Sample const &) const;
+
+    std::optional<Entry> load(Key const &) const;
+    // Does nothing if the explanation is not an interval explanation
+    void store(Key const &, Explanation const &, SampleStats const &) const;
+
+    // Exact textual form of an entry, also used by the checkpoints
+    static void writeEntry(std::ostream &, IntervalExplanation const &, SampleStats const &);
+    static Entry readEntry(Framework const &, std::istream &);
+
+    // The network itself rather than its file, which may be in either of the formats
+    static void hashNetwork(Hash &, xai::nn::NNet const &);
+
+protected:
+    static void writeBounds(std::ostream &, IntervalExplanation const &);
+    static std::unique_ptr<IntervalExplanation> readBounds(Framework const &, std::istream &);
+
+    std::filesystem::path getPath(Key const & key) const { return dirPath / key; }
+
+    Framework const & framework;
+
+    std::filesystem::path dirPath;
+
+    Hash baseHash{};
+};
+} // namespace xspace
+
+#endif // XSPACE_EXPAND_EXPLANATIONCACHE_H
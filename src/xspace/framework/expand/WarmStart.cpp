@@ -0,0 +1,22 @@
+#include "WarmStart.h"
+
+#include "../explanation/Explanation.h"
+
+#include <cassert>
+
+namespace xspace {
+Framework::Expand::WarmStart::WarmStart(Dataset const & data, Explanations const & exps)
+    : dataset{data},
+      explanations{exps},
+      samplesTree{data.getSamplesData(), data.sampleSize()} {
+    assert(explanations.size() == dataset.size());
+}
+
+std::optional<Dataset::Sample::Idx>
+Framework::Expand::WarmStart::findExplainedNeighbor(Dataset::Sample::Idx idx) const {
+    auto const label = dataset.getComputedOutput(idx).classificationLabel;
+    return samplesTree.findNearestActive(dataset.getSample(idx), [&](KdTree::Idx otherIdx) {
+        return dataset.getComputedOutput(otherIdx).classificationLabel == label;
+    });
+}
+} // namespace xspace
@@ -0,0 +1,37 @@
+#ifndef XSPACE_EXPAND_WARMSTART_H
+#define XSPACE_EXPAND_WARMSTART_H
+
+#include "Expand.h"
+
+#include <xspace/common/KdTree.h>
+
+#include <optional>
+
+namespace xspace {
+// Finds the nearest samples that have already been explained, to start from their explanations
+// Which samples are already explained would depend on the timing of the workers, hence only sequential runs use it
+class Framework::Expand::WarmStart {
+public:
+    WarmStart(Dataset const &, Explanations const &);
+
+    // Only the samples with the same computed classification are considered
+    std::optional<Dataset::Sample::Idx> findExplainedNeighbor(Dataset::Sample::Idx) const;
+
+    Explanation const & getExplanation(Dataset::Sample::Idx idx) const {
+        assert(samplesTree.isActive(idx));
+        return *explanations[idx];
+    }
+
+    // The explanation of the sample must not change afterwards
+    void markExplained(Dataset::Sample::Idx idx) { samplesTree.activate(idx); }
+
+protected:
+    Dataset const & dataset;
+    Explanations const & explanations;
+
+    // The explained samples are the active points
+    KdTree samplesTree;
+};
+} // namespace xspace
+
+#endif // XSPACE_EXPAND_WARMSTART_H
@@ -5,7 +5,11 @@
 
 #include <verifiers/Verifier.h>
 
+#include <algorithm>
 #include <cassert>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace xspace {
 void Framework::Expand::AbductiveStrategy::executeBody(std::unique_ptr<Explanation> & explanationPtr) {
@@ -13,16 +17,141 @@ void Framework::Expand::AbductiveStrategy::executeBody(std::unique_ptr<Explanati
     assert(dynamic_cast<IntervalExplanation *>(&explanation));
     auto & iexplanation = static_cast<IntervalExplanation &>(explanation);
 
-    auto & verifier = getVerifier();
+    using xai::verifiers::Verifier;
 
-    for (VarIdx idxToOmit : varOrdering.order) {
-        verifier.push();
-        assertIntervalExplanationExcept(iexplanation, idxToOmit, {.ignoreVarOrder = true});
-        bool const ok = checkFormsExplanation();
-        verifier.pop();
-        // It is no longer explanation after the removal -> we cannot remove it
-        if (not ok) { continue; }
-        iexplanation.eraseVarBound(idxToOmit);
+    // The speculative batches are only checked by the speculators, on input boxes
+    bool const speculativeBatches = speculating() and not config.divideAndConquer;
+
+    // Each var bound is asserted only once as an assumption,
+    // hence each check just omits some of the assumptions instead of re-asserting all the remaining var bounds
+    auto & fw = expand.getFramework();
+    std::size_t const varSize = fw.varSize();
+    std::vector<std::optional<Verifier::Assumption>> varAssumptions(varSize);
+    if (not speculativeBatches) {
+        for (VarIdx idx = 0; idx < varSize; ++idx) {
+            auto * optVarBnd = iexplanation.tryGetVarBound(idx);
+            if (not optVarBnd) { continue; }
+            varAssumptions[idx] = addVarBoundAssumption(*optVarBnd);
+        }
     }
+
+    Verifier::Assumptions assumptions;
+    assumptions.reserve(varSize);
+    std::vector<bool> omitted(varSize);
+    auto const checkFormsExplanationWithout = [&](std::span<VarIdx const> idxsToOmit) {
+        if (usingInputBoxChecks()) {
+            InputBox box = makeInputBox(iexplanation);
+            for (VarIdx idx : idxsToOmit) {
+                Interval const & domainInterval = fw.getDomainInterval(idx);
+                box.lower[idx] = domainInterval.getLower();
+                box.upper[idx] = domainInterval.getUpper();
+            }
+            if (counterexampleRefutesExplanation(box)) { return false; }
+            if (checkFormsExplanationByBoundPropagation(box)) { return true; }
+        }
+
+        for (VarIdx idx : idxsToOmit) {
+            omitted[idx] = true;
+        }
+        assumptions.clear();
+        for (VarIdx idx = 0; idx < varSize; ++idx) {
+            if (omitted[idx]) { continue; }
+            if (auto & optAssumption = varAssumptions[idx]) { assumptions.push_back(*optAssumption); }
+        }
+        for (VarIdx idx : idxsToOmit) {
+            omitted[idx] = false;
+        }
+        return checkFormsExplanationAssuming(assumptions);
+    };
+
+    auto const omit = [&](std::span<VarIdx const> idxsToOmit) {
+        for (VarIdx idx : idxsToOmit) {
+            iexplanation.eraseVarBound(idx);
+            varAssumptions[idx].reset();
+        }
+    };
+
+    if (not config.divideAndConquer and not speculating()) {
+        for (VarIdx idxToOmit : varOrdering.order) {
+            bool const ok = checkFormsExplanationWithout(std::span{&idxToOmit, 1});
+            // It is no longer explanation after the removal -> we cannot remove it
+            if (not ok) { continue; }
+            omit(std::span{&idxToOmit, 1});
+        }
+        return;
+    }
+
+    std::vector<VarIdx> order;
+    order.reserve(varSize);
+    for (VarIdx idx : varOrdering.order) {
+        if (iexplanation.tryGetVarBound(idx)) { order.push_back(idx); }
+    }
+
+    if (speculativeBatches) {
+        // Each candidate of a batch is checked as if all the previous candidates of the batch were omitted
+        // A positive result remains valid even if some of them are kept, because the bounds only get stronger,
+        // but a negative result only if all of them were omitted, which holds at least up to the first negative one
+        // The results are committed in the order until the first one that is not valid
+        std::size_t const maxBatchSize = maxSpeculativeChecks();
+        std::vector<InputBox> boxes;
+        boxes.reserve(maxBatchSize);
+        for (std::size_t pos = 0; pos < order.size();) {
+            auto const batch = std::span{order}.subspan(pos, std::min(maxBatchSize, order.size() - pos));
+            boxes.clear();
+            InputBox box = makeInputBox(iexplanation);
+            for (VarIdx idx : batch) {
+                Interval const & domainInterval = fw.getDomainInterval(idx);
+                box.lower[idx] = domainInterval.getLower();
+                box.upper[idx] = domainInterval.getUpper();
+                boxes.push_back(box);
+            }
+
+            auto const results = checkFormExplanationsSpeculatively(boxes);
+
+            bool allPreviousOmitted = true;
+            std::size_t i = 0;
+            for (; i < batch.size(); ++i) {
+                if (results[i]) {
+                    omit(batch.subspan(i, 1));
+                    continue;
+                }
+                if (not allPreviousOmitted) { break; }
+                // It is no longer explanation after the removal -> we cannot remove it
+                allPreviousOmitted = false;
+            }
+            assert(i > 0);
+
+            expand.sampleStats.discardedChecks += batch.size() - i;
+            pos += i;
+        }
+        return;
+    }
+
+    // Omitting a block at once succeeds iff omitting each of its variables one by one in the linear pass would,
+    // because each of those checks considers a superset of the remaining bounds
+    // Otherwise, the block is split into halves that are processed in the order, as in the linear pass
+
+    // If the whole block is known not to be omittable, the check is skipped
+    auto const omitBlock = [&](auto & self, std::span<VarIdx const> block, bool knownNotOmittable) -> void {
+        if (block.empty()) { return; }
+        if (not knownNotOmittable) {
+            bool const ok = checkFormsExplanationWithout(block);
+            if (ok) {
+                omit(block);
+                return;
+            }
+        }
+
+        if (block.size() == 1) { return; }
+
+        auto const firstHalf = block.first(block.size() / 2);
+        auto const secondHalf = block.subspan(firstHalf.size());
+        self(self, firstHalf, false);
+        // If the whole first half was omitted, the check of the second half would be the same as of the whole block
+        bool const firstHalfOmitted =
+            std::ranges::none_of(firstHalf, [&](VarIdx idx) { return bool(varAssumptions[idx]); });
+        self(self, secondHalf, firstHalfOmitted);
+    };
+    omitBlock(omitBlock, order, false);
 }
 } // namespace xspace
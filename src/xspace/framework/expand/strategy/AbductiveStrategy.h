@@ -6,12 +6,25 @@
 namespace xspace {
 class Framework::Expand::AbductiveStrategy : public Strategy {
 public:
+    struct Config {
+        // Try to omit whole blocks of variables at once and only split the blocks that cannot be omitted
+        // Results in the same explanation as the linear pass, but with fewer checks if the explanation is small
+        // The speculative checks are only used by the linear pass
+        bool divideAndConquer = false;
+    };
+
     using Strategy::Strategy;
+    AbductiveStrategy(Expand & exp, Config const & conf, VarOrdering order = {})
+        : Strategy{exp, std::move(order)},
+          config{conf} {}
 
     static char const * name() { return "abductive"; }
+    char const * getName() const override { return name(); }
 
 protected:
     void executeBody(std::unique_ptr<Explanation> &) override;
+
+    Config config{};
 };
 } // namespace xspace
 
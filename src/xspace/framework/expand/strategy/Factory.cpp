@@ -5,6 +5,7 @@
 #include <xspace/common/Macro.h>
 #include <xspace/common/String.h>
 
+#include <algorithm>
 #include <queue>
 #include <sstream>
 #include <stdexcept>
@@ -15,11 +16,14 @@ Framework::Expand::Strategy::Factory::Factory(Expand & exp, VarOrdering const &
       varOrdering{std::move(order)} {}
 
 std::unique_ptr<Framework::Expand::Strategy> Framework::Expand::Strategy::Factory::parse(std::string const & str) {
-    static constexpr char paramDelim = ',';
-
     std::istringstream iss{str};
     std::string name;
     iss >> name;
+    auto const nameLower = toLower(name);
+
+    std::vector<PortfolioStrategy::Chain> portfolioChains;
+    if (nameLower == PortfolioStrategy::name()) { portfolioChains = parsePortfolioChains(str, iss); }
+
     std::queue<std::string> params;
     std::string param;
     while (std::getline(iss, param, paramDelim)) {
@@ -27,12 +31,11 @@ std::unique_ptr<Framework::Expand::Strategy> Framework::Expand::Strategy::Factor
         params.push(std::move(param));
     }
 
-    auto const nameLower = toLower(name);
-
     if (nameLower == AbductiveStrategy::name()) { return parseAbductive(str, params); }
     if (nameLower == TrialAndErrorStrategy::name()) { return parseTrial(str, params); }
     if (nameLower == expand::opensmt::UnsatCoreStrategy::name()) { return parseUnsatCore(str, params); }
     if (nameLower == expand::opensmt::InterpolationStrategy::name()) { return parseInterpolation(str, params); }
+    if (nameLower == PortfolioStrategy::name()) { return parsePortfolio(str, params, std::move(portfolioChains)); }
 
     throw std::invalid_argument{"Unrecognized strategy name: "s + name};
 }
@@ -75,7 +78,20 @@ std::string Framework::Expand::Strategy::Factory::throwMessageTp(std::string con
 
 std::unique_ptr<Framework::Expand::Strategy>
 Framework::Expand::Strategy::Factory::parseAbductive(std::string const & str, auto & params) {
-    return parseReturnTp<AbductiveStrategy>(str, params);
+    AbductiveStrategy::Config conf;
+    while (not params.empty()) {
+        auto param = std::move(params.front());
+        params.pop();
+        auto const paramLower = toLower(param);
+        if (paramLower == "dc") {
+            conf.divideAndConquer = true;
+            continue;
+        }
+
+        throwInvalidParameterTp<AbductiveStrategy>(param);
+    }
+
+    return parseReturnTp<AbductiveStrategy>(str, params, conf);
 }
 
 std::unique_ptr<Framework::Expand::Strategy> Framework::Expand::Strategy::Factory::parseTrial(std::string const & str,
@@ -91,6 +107,11 @@ std::unique_ptr<Framework::Expand::Strategy> Framework::Expand::Strategy::Factor
             if (paramLower == "n") {
                 if (iss >> conf.maxAttempts) { continue; }
             }
+            if (paramLower == "bisect") {
+                conf.bisect = true;
+                if ((iss >> std::ws).eof()) { continue; }
+                if (iss >> conf.bisectTolerance and conf.bisectTolerance > 0) { continue; }
+            }
         }
 
         throwInvalidParameterTp<TrialAndErrorStrategy>(paramStr);
@@ -225,4 +246,80 @@ Framework::Expand::Strategy::Factory::parseInterpolation(std::string const & str
 
     return parseReturnTp<InterpolationStrategy>(str, params, conf);
 }
+
+std::unique_ptr<Framework::Expand::Strategy>
+Framework::Expand::Strategy::Factory::parsePortfolio(std::string const & str, auto & params,
+                                                     std::vector<PortfolioStrategy::Chain> chains) {
+    PortfolioStrategy::Config conf{.chains = std::move(chains)};
+    while (not params.empty()) {
+        std::string const paramStr = std::move(params.front());
+        std::istringstream iss{paramStr};
+        params.pop();
+        std::string param;
+        if (iss >> param) {
+            auto const paramLower = toLower(param);
+            if (paramLower == "first") {
+                conf.mode = PortfolioStrategy::Mode::first;
+                if ((iss >> std::ws).eof()) { continue; }
+            }
+            if (paramLower == "best") {
+                conf.mode = PortfolioStrategy::Mode::best;
+                if ((iss >> std::ws).eof()) { continue; }
+                if (iss >> conf.deadline and conf.deadline > 0) { continue; }
+            }
+        }
+
+        throwInvalidParameterTp<PortfolioStrategy>(paramStr);
+    }
+
+    if (conf.chains.empty()) { throw std::invalid_argument{throwMessageTp<PortfolioStrategy>("No chains: "s + str)}; }
+
+    return parseReturnTp<PortfolioStrategy>(str, params, conf);
+}
+
+std::vector<Framework::Expand::PortfolioStrategy::Chain>
+Framework::Expand::Strategy::Factory::parsePortfolioChains(std::string const & str, std::istream & is) {
+    static constexpr char chainBegin = '[';
+    static constexpr char chainEnd = ']';
+    // Within a chain, instead of the delimiter of Expand::setStrategies
+    static constexpr char chainStrategyDelim = '+';
+    static constexpr char chainStrategyDelimReplacement = ';';
+    static constexpr char verifierDelim = '@';
+
+    std::vector<PortfolioStrategy::Chain> chains;
+    while ((is >> std::ws).peek() == chainBegin) {
+        is.get();
+        std::string chainStr;
+        std::getline(is, chainStr, chainEnd);
+        if (is.eof()) { throwInvalidParameterTp<PortfolioStrategy>(chainBegin + chainStr); }
+
+        PortfolioStrategy::Chain chain;
+        std::string_view chainSpec = chainStr;
+        if (auto const pos = chainSpec.find(verifierDelim); pos != std::string_view::npos) {
+            chain.verifierName = trim(chainSpec.substr(pos + 1));
+            chainSpec = chainSpec.substr(0, pos);
+        }
+        chain.strategiesSpec = trim(chainSpec);
+        std::ranges::replace(chain.strategiesSpec, chainStrategyDelim, chainStrategyDelimReplacement);
+
+        // Reports invalid chains right away rather than with the first sample
+        Expand chainExpand{expand.framework};
+        std::istringstream chainIss{chain.strategiesSpec};
+        chainExpand.setStrategies(chainIss);
+        if (chainExpand.strategies.empty()) {
+            throwInvalidParameterTp<PortfolioStrategy>(chainBegin + chainStr + chainEnd);
+        }
+        if (not chain.verifierName.empty()) { chainExpand.setVerifier(chain.verifierName); }
+
+        chains.push_back(std::move(chain));
+    }
+
+    if (is.peek() == paramDelim) {
+        is.get();
+    } else if (not is.eof()) {
+        throw std::invalid_argument{throwMessageTp<PortfolioStrategy>("Expected chains or parameters: "s + str)};
+    }
+
+    return chains;
+}
 } // namespace xspace
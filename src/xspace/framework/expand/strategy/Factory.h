@@ -1,9 +1,12 @@
 #ifndef XSPACE_EXPAND_STRATEGY_FACTORY_H
 #define XSPACE_EXPAND_STRATEGY_FACTORY_H
 
+#include "PortfolioStrategy.h"
 #include "Strategy.h"
 
+#include <istream>
 #include <string>
+#include <vector>
 
 namespace xspace {
 class Framework::Expand::Strategy::Factory {
@@ -13,6 +16,8 @@ public:
     std::unique_ptr<Strategy> parse(std::string const &);
 
 protected:
+    static constexpr char paramDelim = ',';
+
     template<typename T>
     std::unique_ptr<Strategy> parseReturnTp(std::string const &, auto const & params, auto &&...) const;
 
@@ -41,6 +46,11 @@ private:
     std::unique_ptr<Strategy> parseTrial(std::string const &, auto & params);
     std::unique_ptr<Strategy> parseUnsatCore(std::string const &, auto & params);
     std::unique_ptr<Strategy> parseInterpolation(std::string const &, auto & params);
+    std::unique_ptr<Strategy> parsePortfolio(std::string const &, auto & params,
+                                             std::vector<PortfolioStrategy::Chain> chains);
+
+    // Must precede the parameters, because the chains may contain the parameter delimiter themselves
+    std::vector<PortfolioStrategy::Chain> parsePortfolioChains(std::string const &, std::istream &);
 };
 } // namespace xspace
 
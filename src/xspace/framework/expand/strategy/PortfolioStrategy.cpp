@@ -0,0 +1,165 @@
+#include "PortfolioStrategy.h"
+
+#include <xspace/framework/Config.h>
+#include <xspace/framework/explanation/IntervalExplanation.h>
+#include <xspace/framework/explanation/VarBound.h>
+
+#include <verifiers/Verifier.h>
+
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace xspace {
+namespace {
+std::unique_ptr<IntervalExplanation> copyIntervalExplanation(Framework const & fw,
+                                                             IntervalExplanation const & iexplanation) {
+    auto copyPtr = std::make_unique<IntervalExplanation>(fw);
+    std::size_t const varSize = fw.varSize();
+    for (VarIdx idx = 0; idx < varSize; ++idx) {
+        if (auto * optVarBnd = iexplanation.tryGetVarBound(idx)) { copyPtr->insertVarBound(*optVarBnd); }
+    }
+    return copyPtr;
+}
+} // namespace
+
+Framework::Expand::PortfolioStrategy::PortfolioStrategy(Expand & exp, Config const & conf, VarOrdering order)
+    : Strategy{exp, std::move(order)},
+      config{conf} {
+    assert(not config.chains.empty());
+}
+
+Framework::Expand::PortfolioStrategy::~PortfolioStrategy() = default;
+
+void Framework::Expand::PortfolioStrategy::executeInit(std::unique_ptr<Explanation> &) {
+    if (racers.empty()) { initRacers(); }
+}
+
+void Framework::Expand::PortfolioStrategy::initRacers() {
+    assert(racers.empty());
+    racers.reserve(config.chains.size());
+    for (auto const & chain : config.chains) {
+        std::string_view const vfName = chain.verifierName.empty() ? expand.verifierName : chain.verifierName;
+        auto racerExpandPtr = expand.makeWorker(chain.strategiesSpec, vfName);
+        racerExpandPtr->initVerifier();
+        racers.push_back({.expandPtr = std::move(racerExpandPtr)});
+    }
+}
+
+void Framework::Expand::PortfolioStrategy::executeBody(std::unique_ptr<Explanation> & explanationPtr) {
+    auto const * iexplanationPtr = dynamic_cast<IntervalExplanation const *>(explanationPtr.get());
+    if (not iexplanationPtr) { throw std::logic_error{"The portfolio strategy supports only interval explanations"}; }
+
+    std::size_t const size = racers.size();
+    auto const startTime = std::chrono::steady_clock::now();
+
+    std::stop_source stopSource;
+    std::mutex mutex;
+    std::condition_variable doneCondition;
+    std::size_t doneCount{};
+    std::exception_ptr exceptionPtr{};
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            threads.emplace_back([&, i] {
+                auto & racer = racers[i];
+                try {
+                    race(racer, *iexplanationPtr, stopSource.get_token());
+                } catch (...) {
+                    std::lock_guard lock{mutex};
+                    if (not exceptionPtr) { exceptionPtr = std::current_exception(); }
+                    stopSource.request_stop();
+                }
+
+                std::lock_guard lock{mutex};
+                racer.finished = not stopSource.stop_requested();
+                if (racer.finished and config.mode == Mode::first) { stopSource.request_stop(); }
+                ++doneCount;
+                doneCondition.notify_all();
+            });
+        }
+
+        if (config.mode == Mode::best and config.deadline > 0) {
+            auto const deadlineTime = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                      std::chrono::duration<double>(config.deadline));
+            std::unique_lock lock{mutex};
+            doneCondition.wait_until(lock, deadlineTime, [&] { return doneCount == size; });
+            stopSource.request_stop();
+        }
+    }
+
+    if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+
+    auto & winner = racers[pickWinner()];
+    explanationPtr = std::move(winner.explanationPtr);
+
+    auto & winnerStats = winner.expandPtr->sampleStats;
+    auto & stats = expand.sampleStats;
+    stats.checks += winnerStats.checks;
+    stats.skippedChecks += winnerStats.skippedChecks;
+    stats.cachedChecks += winnerStats.cachedChecks;
+    if (winnerStats.truncated) { stats.truncated = true; }
+
+    for (auto & racer : racers) {
+        racer.explanationPtr.reset();
+        racer.expandPtr->sampleStats = {};
+    }
+}
+
+void Framework::Expand::PortfolioStrategy::race(Racer & racer, IntervalExplanation const & iexplanation,
+                                                std::stop_token stopToken) {
+    auto & racerExpand = *racer.expandPtr;
+    bool const persistentModel = expand.getFramework().getConfig().usingPersistentModel();
+    assert(expand.classificationOutputPtr);
+
+    if (racer.asserted) { resetRacer(racer); }
+
+    racerExpand.stopToken = std::move(stopToken);
+    // The per-sample budget is shared with the portfolio
+    racerExpand.sampleStartTime = expand.sampleStartTime;
+
+    if (not persistentModel) { racerExpand.assertModel(); }
+    racerExpand.assertClassification(*expand.classificationOutputPtr);
+    racer.asserted = true;
+
+    racer.explanationPtr = copyIntervalExplanation(expand.getFramework(), iexplanation);
+    racerExpand.executeStrategies(racer.explanationPtr);
+    racerExpand.sampleStats.checks = racerExpand.verifierPtr->getChecksCount();
+
+    racerExpand.stopToken = {};
+}
+
+void Framework::Expand::PortfolioStrategy::resetRacer(Racer & racer) {
+    assert(racer.asserted);
+    auto & racerExpand = *racer.expandPtr;
+    racerExpand.resetClassification();
+    if (not expand.getFramework().getConfig().usingPersistentModel()) { racerExpand.resetModel(); }
+    racer.asserted = false;
+}
+
+std::size_t Framework::Expand::PortfolioStrategy::pickWinner() const {
+    std::size_t const size = racers.size();
+    assert(size > 0);
+
+    // The explanations of the stopped racers are valid too, but possibly far from minimal
+    auto const isBetter = [&](std::size_t i, std::size_t j) {
+        auto const & racer = racers[i];
+        auto const & other = racers[j];
+        if (racer.finished != other.finished) { return racer.finished; }
+        return racer.explanationPtr->getRelativeVolumeSkipFixed() >
+               other.explanationPtr->getRelativeVolumeSkipFixed();
+    };
+
+    std::size_t winnerIdx = 0;
+    for (std::size_t i = 1; i < size; ++i) {
+        if (isBetter(i, winnerIdx)) { winnerIdx = i; }
+    }
+    return winnerIdx;
+}
+} // namespace xspace
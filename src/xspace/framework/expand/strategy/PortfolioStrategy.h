@@ -0,0 +1,76 @@
+#ifndef XSPACE_EXPAND_PORTFOLIOSTRATEGY_H
+#define XSPACE_EXPAND_PORTFOLIOSTRATEGY_H
+
+#include "Strategy.h"
+
+#include <cstddef>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+namespace xspace {
+// Races several chains of strategies on the same sample, each with its own verifier and in its own thread
+// The losers are stopped cooperatively: their remaining checks answer UNKNOWN, which keeps their explanations valid
+class Framework::Expand::PortfolioStrategy : public Strategy {
+public:
+    enum class Mode {
+        // The first chain that finishes wins
+        first,
+        // The chain with the largest relative volume wins, out of those that finish before the deadline
+        best
+    };
+
+    struct Chain {
+        // The strategies are delimited as in Expand::setStrategies
+        std::string strategiesSpec;
+        // If empty, the same verifier as the one of the portfolio
+        std::string verifierName{};
+    };
+
+    struct Config {
+        std::vector<Chain> chains{};
+        Mode mode = Mode::first;
+        // In seconds from the start of the race, zero means waiting for all the chains
+        double deadline = 0;
+    };
+
+    PortfolioStrategy(Expand &, Config const &, VarOrdering = {});
+    ~PortfolioStrategy();
+
+    static char const * name() { return "portfolio"; }
+    char const * getName() const override { return name(); }
+
+protected:
+    struct Racer {
+        std::unique_ptr<Expand> expandPtr{};
+        std::unique_ptr<Explanation> explanationPtr{};
+        // Not stopped before all its strategies finished
+        bool finished{};
+        // The constraints of the previous sample are kept until the next race,
+        // as the explanation of the winner may refer to the terms of its verifier until it is printed
+        bool asserted{};
+    };
+
+    // The verifier of the portfolio itself is not used
+    void executeInit(std::unique_ptr<Explanation> &) override;
+    void executeBody(std::unique_ptr<Explanation> &) override;
+    void executeFinish(std::unique_ptr<Explanation> &) override {}
+
+    // The racers are only constructed with the first sample, when the verifier of the portfolio is known
+    void initRacers();
+
+    // Runs the chain of the racer on its own copy of the explanation
+    void race(Racer &, IntervalExplanation const &, std::stop_token);
+    void resetRacer(Racer &);
+
+    // Prefers the racers that finished, and then the larger relative volume
+    std::size_t pickWinner() const;
+
+    Config config{};
+
+    std::vector<Racer> racers{};
+};
+} // namespace xspace
+
+#endif // XSPACE_EXPAND_PORTFOLIOSTRATEGY_H
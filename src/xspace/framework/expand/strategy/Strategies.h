@@ -4,6 +4,7 @@
 #include "Strategy.h"
 
 #include "AbductiveStrategy.h"
+#include "PortfolioStrategy.h"
 #include "TrialAndErrorStrategy.h"
 #include "UnsatCoreStrategy.h"
 #include "opensmt/InterpolationStrategy.h"
@@ -1,5 +1,6 @@
 #include "Strategy.h"
 
+#include <xspace/framework/Config.h>
 #include <xspace/framework/explanation/ConjunctExplanation.h>
 #include <xspace/framework/explanation/Explanation.h>
 #include <xspace/framework/explanation/IntervalExplanation.h>
@@ -295,9 +296,142 @@ void Framework::Expand::Strategy::assertEquality(VarIdx idx, EqBound const & eq)
     getVerifier().addEquality(0, idx, val, storeNamedTerms());
 }
 
+xai::verifiers::Verifier::Assumption Framework::Expand::Strategy::addVarBoundAssumption(VarBound const & varBnd) {
+    auto & verifier = getVerifier();
+    VarIdx const idx = varBnd.getVarIdx();
+    if (varBnd.isInterval()) {
+        Float const loVal = varBnd.getIntervalLower().getValue();
+        Float const hiVal = varBnd.getIntervalUpper().getValue();
+        assert(loVal > expand.getFramework().getNetwork().getInputLowerBound(idx));
+        assert(hiVal < expand.getFramework().getNetwork().getInputUpperBound(idx));
+        return verifier.addIntervalAssumption(0, idx, loVal, hiVal);
+    }
+
+    auto & bnd = varBnd.getBound();
+    Float const val = bnd.getValue();
+    if (bnd.isEq()) {
+        assert(val >= expand.getFramework().getNetwork().getInputLowerBound(idx));
+        assert(val <= expand.getFramework().getNetwork().getInputUpperBound(idx));
+        return verifier.addEqualityAssumption(0, idx, val);
+    }
+
+    assert(val > expand.getFramework().getNetwork().getInputLowerBound(idx));
+    assert(val < expand.getFramework().getNetwork().getInputUpperBound(idx));
+    if (bnd.isLower()) { return verifier.addLowerBoundAssumption(0, idx, val); }
+
+    assert(bnd.isUpper());
+    return verifier.addUpperBoundAssumption(0, idx, val);
+}
+
 bool Framework::Expand::Strategy::checkFormsExplanation() {
+    if (not expand.applyCheckBudget()) { return false; }
+
     auto answer = getVerifier().check();
-    assert(answer == xai::verifiers::Verifier::Answer::SAT or answer == xai::verifiers::Verifier::Answer::UNSAT);
+    // UNKNOWN is possible with incomplete verifiers or exceeded budgets and must be treated as not proven
+    assert(answer != xai::verifiers::Verifier::Answer::ERROR);
+    if (answer == xai::verifiers::Verifier::Answer::SAT and expand.counterexampleCachePtr) {
+        expand.recordCounterexample();
+    }
+    if (answer == xai::verifiers::Verifier::Answer::UNKNOWN) { expand.noteUnknownAnswer(); }
+    return (answer == xai::verifiers::Verifier::Answer::UNSAT);
+}
+
+bool Framework::Expand::Strategy::checkFormsExplanationByBoundPropagation(IntervalExplanation const & iexplanation,
+                                                                          VarIdx idx, Interval const & ival) {
+    if (not expand.getFramework().getConfig().usingBoundPropagation()) { return false; }
+
+    return checkFormsExplanationByBoundPropagation(makeInputBox(iexplanation, idx, ival));
+}
+
+bool Framework::Expand::Strategy::checkFormsExplanationByBoundPropagation(InputBox const & box) {
+    if (not expand.getFramework().getConfig().usingBoundPropagation()) { return false; }
+
+    bool const proved = expand.boundPropagationProvesClassification(box);
+    if (proved) { ++expand.sampleStats.skippedChecks; }
+    return proved;
+}
+
+bool Framework::Expand::Strategy::counterexampleRefutesExplanation(IntervalExplanation const & iexplanation,
+                                                                   VarIdx idx, Interval const & ival) {
+    if (not expand.counterexampleCachePtr) { return false; }
+
+    return counterexampleRefutesExplanation(makeInputBox(iexplanation, idx, ival));
+}
+
+bool Framework::Expand::Strategy::counterexampleRefutesExplanation(InputBox const & box) {
+    if (not expand.counterexampleCachePtr) { return false; }
+
+    bool const refuted = expand.counterexampleCacheContainsPointIn(box);
+    if (refuted) { ++expand.sampleStats.cachedChecks; }
+    return refuted;
+}
+
+std::vector<bool> Framework::Expand::Strategy::checkFormExplanationsSpeculatively(std::span<InputBox const> boxes) {
+    std::size_t const size = boxes.size();
+    assert(size <= maxSpeculativeChecks());
+
+    // The cheap checks are tried first and only the remaining boxes are passed to the speculators
+    std::vector<bool> results(size);
+    std::vector<std::size_t> pendingIndices;
+    std::vector<InputBox> pendingBoxes;
+    for (std::size_t i = 0; i < size; ++i) {
+        auto const & box = boxes[i];
+        if (counterexampleRefutesExplanation(box)) { continue; }
+        if (checkFormsExplanationByBoundPropagation(box)) {
+            results[i] = true;
+            continue;
+        }
+        pendingIndices.push_back(i);
+        pendingBoxes.push_back(box);
+    }
+
+    if (pendingBoxes.empty()) { return results; }
+
+    auto const pendingResults = expand.checkBoxesFormExplanationSpeculatively(pendingBoxes);
+    for (std::size_t j = 0; j < pendingIndices.size(); ++j) {
+        results[pendingIndices[j]] = pendingResults[j];
+    }
+    return results;
+}
+
+bool Framework::Expand::Strategy::usingInputBoxChecks() const {
+    return expand.getFramework().getConfig().usingBoundPropagation() or expand.counterexampleCachePtr;
+}
+
+Framework::Expand::InputBox Framework::Expand::Strategy::makeInputBox(IntervalExplanation const & iexplanation) const {
+    auto & fw = expand.getFramework();
+    std::size_t const varSize = fw.varSize();
+    InputBox box;
+    box.lower.reserve(varSize);
+    box.upper.reserve(varSize);
+    for (VarIdx i = 0; i < varSize; ++i) {
+        auto * optVarBnd = iexplanation.tryGetVarBound(i);
+        Interval const ivalOfVar = optVarBnd ? optVarBnd->toInterval() : fw.getDomainInterval(i);
+        box.lower.push_back(ivalOfVar.getLower());
+        box.upper.push_back(ivalOfVar.getUpper());
+    }
+    return box;
+}
+
+Framework::Expand::InputBox Framework::Expand::Strategy::makeInputBox(IntervalExplanation const & iexplanation,
+                                                                      VarIdx idx, Interval const & ival) const {
+    InputBox box = makeInputBox(iexplanation);
+    box.lower[idx] = ival.getLower();
+    box.upper[idx] = ival.getUpper();
+    return box;
+}
+
+bool Framework::Expand::Strategy::checkFormsExplanationAssuming(
+    xai::verifiers::Verifier::Assumptions const & assumptions) {
+    if (not expand.applyCheckBudget()) { return false; }
+
+    auto answer = getVerifier().checkAssuming(assumptions);
+    // UNKNOWN is possible with incomplete verifiers or exceeded budgets and must be treated as not proven
+    assert(answer != xai::verifiers::Verifier::Answer::ERROR);
+    if (answer == xai::verifiers::Verifier::Answer::SAT and expand.counterexampleCachePtr) {
+        expand.recordCounterexample();
+    }
+    if (answer == xai::verifiers::Verifier::Answer::UNKNOWN) { expand.noteUnknownAnswer(); }
     return (answer == xai::verifiers::Verifier::Answer::UNSAT);
 }
 } // namespace xspace
@@ -3,6 +3,8 @@
 
 #include "../Expand.h"
 
+#include <verifiers/Verifier.h>
+
 #include <xspace/common/Bound.h>
 #include <xspace/common/Interval.h>
 
@@ -21,8 +23,10 @@ public:
     virtual ~Strategy() = default;
 
     static char const * name() = delete;
+    virtual char const * getName() const = 0;
 
     virtual bool requiresSMTSolver() const { return false; }
+    virtual bool requiresInputModels() const { return false; }
 
     virtual void execute(std::unique_ptr<Explanation> &);
 
@@ -73,7 +77,34 @@ protected:
     void assertUpperBound(VarIdx, UpperBound const &);
     void assertEquality(VarIdx, EqBound const &);
 
+    // Unlike the asserts above, the assumptions are only considered within `checkFormsExplanationAssuming`
+    xai::verifiers::Verifier::Assumption addVarBoundAssumption(VarBound const &);
+
     bool checkFormsExplanation();
+    bool checkFormsExplanationAssuming(xai::verifiers::Verifier::Assumptions const &);
+
+    // Cheap alternative to the checks above that does not involve the verifier, but may fail to prove it
+    // Considers the explanation where the bound of the given variable is replaced by the interval
+    // Always false if the bound propagation is not enabled
+    bool checkFormsExplanationByBoundPropagation(IntervalExplanation const &, VarIdx, Interval const &);
+    bool checkFormsExplanationByBoundPropagation(InputBox const &);
+    // The opposite: whether a counterexample from the previous checks proves that it does *not* form an explanation
+    // Always false if the counterexample cache is not enabled
+    bool counterexampleRefutesExplanation(IntervalExplanation const &, VarIdx, Interval const &);
+    bool counterexampleRefutesExplanation(InputBox const &);
+
+    // Whether any of the two checks above is enabled, otherwise the input boxes need not be constructed
+    bool usingInputBoxChecks() const;
+
+    InputBox makeInputBox(IntervalExplanation const &) const;
+    InputBox makeInputBox(IntervalExplanation const &, VarIdx, Interval const &) const;
+
+    // Zero if the speculative checks are not enabled
+    std::size_t maxSpeculativeChecks() const { return expand.speculators.size(); }
+    bool speculating() const { return maxSpeculativeChecks() > 0; }
+    // Checks in parallel whether each of the boxes forms an explanation, at most `maxSpeculativeChecks` at once
+    // It is up to the strategy to decide which of the results are still valid after committing the earlier ones
+    std::vector<bool> checkFormExplanationsSpeculatively(std::span<InputBox const>);
 
     Expand & expand;
 
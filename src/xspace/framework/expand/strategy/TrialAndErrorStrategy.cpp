@@ -6,7 +6,11 @@
 
 #include <verifiers/Verifier.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <optional>
+#include <vector>
 
 namespace xspace {
 void Framework::Expand::TrialAndErrorStrategy::executeBody(std::unique_ptr<Explanation> & explanationPtr) {
@@ -19,6 +23,11 @@ void Framework::Expand::TrialAndErrorStrategy::executeBody(std::unique_ptr<Expla
     auto const maxAttempts = config.maxAttempts;
     assert(maxAttempts > 0);
 
+    if (speculating()) {
+        executeSpeculativeBody(iexplanation);
+        return;
+    }
+
     for (VarIdx idxToRelax : varOrdering.order) {
         auto * optVarBndToRelax = iexplanation.tryGetVarBound(idxToRelax);
         if (not optVarBndToRelax) { continue; }
@@ -34,14 +43,21 @@ void Framework::Expand::TrialAndErrorStrategy::executeBody(std::unique_ptr<Expla
         assert(dLo <= oLo and oHi <= dHi);
         assert(dLo < oLo or oHi < dHi);
 
-        if (oLo != dLo) {
+        if (config.bisect) { origInterval = relaxByBisection(iexplanation, idxToRelax, std::move(origInterval)); }
+
+        if (not config.bisect and oLo != dLo) {
             verifier.push();
             Interval relaxedLowerIval{dLo, oHi};
             for (int i = 0; i < maxAttempts; ++i) {
                 Float const lo = relaxedLowerIval.getLower();
                 assert(lo < oLo);
-                assertInterval(idxToRelax, relaxedLowerIval);
-                bool const ok = checkFormsExplanation();
+                bool const refuted = counterexampleRefutesExplanation(iexplanation, idxToRelax, relaxedLowerIval);
+                bool ok = not refuted and
+                          checkFormsExplanationByBoundPropagation(iexplanation, idxToRelax, relaxedLowerIval);
+                if (not ok and not refuted) {
+                    assertInterval(idxToRelax, relaxedLowerIval);
+                    ok = checkFormsExplanation();
+                }
                 if (ok) {
                     oLo = lo;
                     origInterval.setLower(oLo);
@@ -52,14 +68,19 @@ void Framework::Expand::TrialAndErrorStrategy::executeBody(std::unique_ptr<Expla
             verifier.pop();
         }
 
-        if (oHi != dHi) {
+        if (not config.bisect and oHi != dHi) {
             verifier.push();
             Interval relaxedUpperIval{oLo, dHi};
             for (int i = 0; i < maxAttempts; ++i) {
                 Float const hi = relaxedUpperIval.getUpper();
                 assert(hi > oHi);
-                assertInterval(idxToRelax, relaxedUpperIval);
-                bool const ok = checkFormsExplanation();
+                bool const refuted = counterexampleRefutesExplanation(iexplanation, idxToRelax, relaxedUpperIval);
+                bool ok = not refuted and
+                          checkFormsExplanationByBoundPropagation(iexplanation, idxToRelax, relaxedUpperIval);
+                if (not ok and not refuted) {
+                    assertInterval(idxToRelax, relaxedUpperIval);
+                    ok = checkFormsExplanation();
+                }
                 if (ok) {
                     oHi = hi;
                     origInterval.setUpper(oHi);
@@ -76,4 +97,159 @@ void Framework::Expand::TrialAndErrorStrategy::executeBody(std::unique_ptr<Expla
         iexplanation[idxToRelax] = std::move(varBndPtr);
     }
 }
+
+void Framework::Expand::TrialAndErrorStrategy::executeSpeculativeBody(IntervalExplanation & iexplanation) {
+    auto & fw = expand.getFramework();
+    auto const maxAttempts = config.maxAttempts;
+    assert(maxAttempts > 0);
+
+    // The attempts of a relaxation do not depend on each other, hence they are checked at once
+    // and only the first successful one is committed, as if they were tried one by one
+    std::size_t const maxBatchSize = maxSpeculativeChecks();
+    std::vector<Interval> attemptIntervals;
+    std::vector<InputBox> boxes;
+    auto const firstSuccessfulAttempt = [&](VarIdx idxToRelax) -> std::optional<Interval> {
+        for (std::size_t pos = 0; pos < attemptIntervals.size();) {
+            std::size_t const batchSize = std::min(maxBatchSize, attemptIntervals.size() - pos);
+            boxes.clear();
+            for (std::size_t i = pos; i < pos + batchSize; ++i) {
+                boxes.push_back(makeInputBox(iexplanation, idxToRelax, attemptIntervals[i]));
+            }
+
+            auto const results = checkFormExplanationsSpeculatively(boxes);
+            auto const it = std::ranges::find(results, true);
+            if (it != results.end()) {
+                std::size_t const i = it - results.begin();
+                expand.sampleStats.discardedChecks += batchSize - i - 1;
+                return attemptIntervals[pos + i];
+            }
+            pos += batchSize;
+        }
+        return std::nullopt;
+    };
+
+    for (VarIdx idxToRelax : varOrdering.order) {
+        auto * optVarBndToRelax = iexplanation.tryGetVarBound(idxToRelax);
+        if (not optVarBndToRelax) { continue; }
+
+        auto & varBndToRelax = *optVarBndToRelax;
+        Interval origInterval = varBndToRelax.toInterval();
+        Interval const & domainInterval = fw.getDomainInterval(idxToRelax);
+        auto [oLo, oHi] = origInterval.getBounds();
+        auto const [dLo, dHi] = domainInterval.getBounds();
+        assert(dLo <= oLo and oHi <= dHi);
+        assert(dLo < oLo or oHi < dHi);
+
+        if (config.bisect) { origInterval = relaxByBisection(iexplanation, idxToRelax, std::move(origInterval)); }
+
+        if (not config.bisect and oLo != dLo) {
+            attemptIntervals.clear();
+            Interval relaxedLowerIval{dLo, oHi};
+            for (int i = 0; i < maxAttempts; ++i) {
+                attemptIntervals.push_back(relaxedLowerIval);
+                relaxedLowerIval.setLower((relaxedLowerIval.getLower() + oLo) / 2);
+            }
+            if (auto optIval = firstSuccessfulAttempt(idxToRelax)) {
+                oLo = optIval->getLower();
+                origInterval.setLower(oLo);
+            }
+        }
+
+        if (not config.bisect and oHi != dHi) {
+            attemptIntervals.clear();
+            Interval relaxedUpperIval{oLo, dHi};
+            for (int i = 0; i < maxAttempts; ++i) {
+                attemptIntervals.push_back(relaxedUpperIval);
+                relaxedUpperIval.setUpper((relaxedUpperIval.getUpper() + oHi) / 2);
+            }
+            if (auto optIval = firstSuccessfulAttempt(idxToRelax)) {
+                oHi = optIval->getUpper();
+                origInterval.setUpper(oHi);
+            }
+        }
+
+        auto varBndPtr = intervalToOptVarBound(fw, idxToRelax, std::move(origInterval));
+        iexplanation[idxToRelax] = std::move(varBndPtr);
+    }
+}
+
+Interval Framework::Expand::TrialAndErrorStrategy::relaxByBisection(IntervalExplanation const & iexplanation,
+                                                                    VarIdx idxToRelax, Interval ival) {
+    auto const [dLo, dHi] = expand.getFramework().getDomainInterval(idxToRelax).getBounds();
+    if (ival.getLower() != dLo) { ival.setLower(bisectBound(iexplanation, idxToRelax, ival, true)); }
+    if (ival.getUpper() != dHi) { ival.setUpper(bisectBound(iexplanation, idxToRelax, ival, false)); }
+    return ival;
+}
+
+Float Framework::Expand::TrialAndErrorStrategy::bisectBound(IntervalExplanation const & iexplanation,
+                                                            VarIdx idxToRelax, Interval const & ival, bool relaxLower) {
+    auto & verifier = getVerifier();
+    auto const [dLo, dHi] = expand.getFramework().getDomainInterval(idxToRelax).getBounds();
+    Float const tolerance = config.bisectTolerance * (dHi - dLo);
+    auto const makeRelaxedInterval = [&](Float val) {
+        return relaxLower ? Interval{val, ival.getUpper()} : Interval{ival.getLower(), val};
+    };
+
+    // `good` is the widest bound known to form an explanation, and `bad` the narrowest one known not to,
+    // except that the domain bound has not been checked yet
+    Float good = relaxLower ? ival.getLower() : ival.getUpper();
+    Float bad = relaxLower ? dLo : dHi;
+    bool badChecked = false;
+
+    // The checked values go from `bad` towards `good`, with as many values at once as there are speculators
+    std::size_t const batchSize = speculating() ? maxSpeculativeChecks() : 1;
+    std::vector<Float> values;
+    std::vector<bool> results;
+    std::vector<InputBox> boxes;
+    while (not badChecked or std::abs(good - bad) > tolerance) {
+        values.clear();
+        if (not badChecked) { values.push_back(bad); }
+        std::size_t const nInnerValues = batchSize - values.size();
+        for (std::size_t i = 1; i <= nInnerValues; ++i) {
+            Float const val = bad + (good - bad) * i / (nInnerValues + 1);
+            // The values may coincide after the rounding
+            if (val == bad or val == good or (not values.empty() and val == values.back())) { continue; }
+            values.push_back(val);
+        }
+        if (values.empty()) { break; }
+        badChecked = true;
+
+        std::optional<Float> optCounterexampleVal;
+        if (speculating()) {
+            boxes.clear();
+            for (Float val : values) {
+                boxes.push_back(makeInputBox(iexplanation, idxToRelax, makeRelaxedInterval(val)));
+            }
+            results = checkFormExplanationsSpeculatively(boxes);
+        } else {
+            assert(values.size() == 1);
+            Interval const relaxedIval = makeRelaxedInterval(values.front());
+            bool const refuted = counterexampleRefutesExplanation(iexplanation, idxToRelax, relaxedIval);
+            bool ok = not refuted and checkFormsExplanationByBoundPropagation(iexplanation, idxToRelax, relaxedIval);
+            if (not ok and not refuted) {
+                verifier.push();
+                assertInterval(idxToRelax, relaxedIval);
+                ok = checkFormsExplanation();
+                auto const & model = verifier.getInputModel();
+                if (not ok and not model.empty()) { optCounterexampleVal = model[idxToRelax]; }
+                verifier.pop();
+            }
+            results.assign(1, ok);
+        }
+
+        std::size_t const pos = std::ranges::find(results, true) - results.begin();
+        if (pos < values.size()) { good = values[pos]; }
+        if (pos > 0) { bad = values[pos - 1]; }
+
+        // Any bound beyond the counterexample would include it too
+        if (not optCounterexampleVal) { continue; }
+        Float const counterexampleVal = *optCounterexampleVal;
+        if (relaxLower ? (bad < counterexampleVal and counterexampleVal < good)
+                       : (good < counterexampleVal and counterexampleVal < bad)) {
+            bad = counterexampleVal;
+        }
+    }
+
+    return good;
+}
 } // namespace xspace
@@ -8,6 +8,10 @@ class Framework::Expand::TrialAndErrorStrategy : public Strategy {
 public:
     struct Config {
         int maxAttempts = 4;
+        // Instead of the attempts, bisect between the widest bound that was proven and the narrowest one that was not,
+        // until their distance relative to the domain drops below the tolerance
+        bool bisect = false;
+        Float bisectTolerance = 0.01;
     };
 
     using Strategy::Strategy;
@@ -16,9 +20,19 @@ public:
           config{conf} {}
 
     static char const * name() { return "trial"; }
+    char const * getName() const override { return name(); }
+
+    // The counterexamples of the checks narrow down the bisection
+    bool requiresInputModels() const override { return config.bisect; }
 
 protected:
     void executeBody(std::unique_ptr<Explanation> &) override;
+    // Results in the same explanation as the body above
+    void executeSpeculativeBody(IntervalExplanation &);
+
+    // Unless speculating, the explanation except the variable must have been asserted
+    Interval relaxByBisection(IntervalExplanation const &, VarIdx, Interval);
+    Float bisectBound(IntervalExplanation const &, VarIdx, Interval const &, bool relaxLower);
 
     Config config{};
 };
@@ -47,8 +47,8 @@ void Framework::Expand::UnsatCoreStrategy::executeBody(ConjunctExplanation & cex
     // In order to map assertions to explanations, we need the conjunction not to be sparse
     cexplanation.condense();
     assertConjunctExplanation(cexplanation, {.ignoreVarOrder = true, .splitIntervals = false});
-    [[maybe_unused]] bool const ok = checkFormsExplanation();
-    assert(ok);
+    // Only possible if the check exceeded its budget, then the current explanation is kept as is
+    if (not checkFormsExplanation()) { return; }
 
     auto & verifier = getVerifier();
 
@@ -91,8 +91,8 @@ void Framework::Expand::UnsatCoreStrategy::executeBody(IntervalExplanation & iex
     bool const splitIntervals = config.splitIntervals;
 
     assertIntervalExplanation(iexplanation, {.ignoreVarOrder = false, .splitIntervals = splitIntervals});
-    [[maybe_unused]] bool const ok = checkFormsExplanation();
-    assert(ok);
+    // Only possible if the check exceeded its budget, then the current explanation is kept as is
+    if (not checkFormsExplanation()) { return; }
 
     auto & fw = expand.getFramework();
     auto & verifier = getVerifier();
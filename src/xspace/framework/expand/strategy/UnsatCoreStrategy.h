@@ -23,6 +23,7 @@ public:
           config{conf} {}
 
     static char const * name() { return "ucore"; }
+    char const * getName() const override { return name(); }
 
     // Does not strictly require SMT solver
     using Strategy::requiresSMTSolver;
@@ -90,8 +90,8 @@ void InterpolationStrategy::executeBody(std::unique_ptr<Explanation> & explanati
     assertConjunctExplanation(cexplanation, {.ignoreVarOrder = true});
     auto const lastFormulaIdx = solver.getAssertionsCount() - 1;
 
-    [[maybe_unused]] bool const ok = checkFormsExplanation();
-    assert(ok);
+    // Only possible if the check exceeded its budget, then the current explanation is kept as is
+    if (not checkFormsExplanation()) { return; }
 
     ::opensmt::ipartitions_t part = 0;
     assert(not cexplanation.isSparse());
@@ -140,7 +140,7 @@ void InterpolationStrategy::executeBody(std::unique_ptr<Explanation> & explanati
 #endif
 
     if (not filteringVars and not itpIsConj) {
-        assignNew<FormulaExplanation>(explanationPtr, fw, itp);
+        assignNew<FormulaExplanation>(explanationPtr, fw, verifier, itp);
         return;
     }
 
@@ -149,7 +149,7 @@ void InterpolationStrategy::executeBody(std::unique_ptr<Explanation> & explanati
     auto const insertItp = [&](Formula const & phi) {
         assert(not logic.isAnd(phi));
         assert(logic.isOr(phi) or isLit(phi) or (logic.isNot(phi) and logic.isAnd(logic.getPterm(phi)[0])));
-        auto phiexplanationPtr = std::make_unique<FormulaExplanation>(fw, phi);
+        auto phiexplanationPtr = std::make_unique<FormulaExplanation>(fw, verifier, phi);
         newConjExplanation.insertExplanation(std::move(phiexplanationPtr));
     };
 
@@ -24,6 +24,7 @@ public:
           config{conf} {}
 
     static char const * name() { return "itp"; }
+    char const * getName() const override { return name(); }
 
 protected:
     void executeInit(std::unique_ptr<Explanation> &) override;
@@ -6,6 +6,7 @@
 
 #include <api/MainSolver.h>
 
+#include <atomic>
 #include <cassert>
 
 namespace xspace::expand::opensmt {
@@ -37,7 +38,8 @@ void Strategy::assertFormulaExplanation(FormulaExplanation const & phiexplanatio
                                         [[maybe_unused]] AssertExplanationConf const & conf) {
     assert(not conf.splitIntervals);
 
-    static std::size_t counter{};
+    // Shared by all workers, each name must be unique within a solver
+    static std::atomic<std::size_t> counter{};
 
     Formula const & phi = phiexplanation.getFormula();
 
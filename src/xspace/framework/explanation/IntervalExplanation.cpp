@@ -6,7 +6,10 @@
 #include <xspace/common/Print.h>
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <ostream>
+#include <string>
 
 namespace xspace {
 IntervalExplanation::IntervalExplanation(Framework const & fw) : ConjunctExplanation{fw, fw.varSize()} {
@@ -149,6 +152,9 @@ void IntervalExplanation::print(std::ostream & os) const {
         case intervals:
             printIntervals(os);
             return;
+        case binary:
+            printBinary(os);
+            return;
     }
 }
 
@@ -165,6 +171,9 @@ void IntervalExplanation::print(std::ostream & os, PrintConfig const & conf) con
         case intervals:
             printIntervals(os, conf);
             return;
+        case binary:
+            printBinary(os);
+            return;
     }
 }
 
@@ -176,6 +185,45 @@ void IntervalExplanation::printIntervals(std::ostream & os, PrintConfig const &
     printTp<PrintFormat::intervals>(os, conf);
 }
 
+void IntervalExplanation::printBinary(std::ostream & os) const {
+    constexpr Float inf = std::numeric_limits<Float>::infinity();
+
+    auto const size_ = size();
+    std::size_t const bitmapSize = binaryBitmapSize(size_);
+    std::string buf(bitmapSize, '\0');
+    buf.reserve(bitmapSize + 2 * sizeof(Float) * varSize());
+
+    auto const append = [&buf](Float val) { buf.append(reinterpret_cast<char const *>(&val), sizeof(val)); };
+
+    for (VarIdx idx = 0; idx < size_; ++idx) {
+        auto const * optVarBnd = tryGetVarBound(idx);
+        if (not optVarBnd) { continue; }
+        auto & varBnd = *optVarBnd;
+
+        buf[idx / 8] |= char(1 << (idx % 8));
+        if (varBnd.isInterval()) {
+            append(varBnd.getIntervalLower().getValue());
+            append(varBnd.getIntervalUpper().getValue());
+            continue;
+        }
+
+        auto & bnd = varBnd.getBound();
+        Float const val = bnd.getValue();
+        append(bnd.isUpper() ? -inf : val);
+        append(bnd.isLower() ? inf : val);
+    }
+
+    os.write(buf.data(), buf.size());
+}
+
+static_assert(sizeof(IntervalExplanation::BinaryHeader) == IntervalExplanation::BinaryHeader::magic.size() + 8);
+
+void IntervalExplanation::printBinaryHeader(std::ostream & os, std::size_t varSize) {
+    BinaryHeader header{.magicBuf = {}, .varSize = std::uint32_t(varSize), .floatSize = sizeof(Float)};
+    std::memcpy(header.magicBuf, BinaryHeader::magic.data(), BinaryHeader::magic.size());
+    os.write(reinterpret_cast<char const *>(&header), sizeof(header));
+}
+
 template<IntervalExplanation::PrintFormat type>
 void IntervalExplanation::printTp(std::ostream & os, PrintConfig const & conf) const {
     constexpr bool isSmtLib2 = (type == PrintFormat::smtlib2);
@@ -9,13 +9,27 @@
 #include <xspace/common/Interval.h>
 
 #include <cassert>
+#include <cstdint>
+#include <string_view>
 
 namespace xspace {
 //! only some things are shared with ConjunctExplanation but not all - there should be a common base class
 // then it will also hold that IntervalExplanation is not ConjunctExplanation, only e.g. ConjunctExplanationBase
 class IntervalExplanation : public ConjunctExplanation {
 public:
-    enum class PrintFormat { smtlib2, bounds, intervals };
+    enum class PrintFormat { smtlib2, bounds, intervals, binary };
+
+    // The binary format consists of a header followed by a record per explanation:
+    // a bitmap of the constrained variables and the packed lower and upper bounds of each of them,
+    // where a missing bound is infinite and a point has equal bounds
+    // All values are stored in the native byte order
+    struct BinaryHeader {
+        static constexpr std::string_view magic = "XSPACEB1";
+
+        char magicBuf[magic.size()];
+        std::uint32_t varSize;
+        std::uint32_t floatSize;
+    };
 
     struct PrintConfig : ConjunctExplanation::PrintConfig {
         bool includeAll;
@@ -56,6 +70,11 @@ public:
     void print(std::ostream &, PrintConfig const &) const;
     void printBounds(std::ostream &, PrintConfig const &) const;
     void printIntervals(std::ostream &, PrintConfig const &) const;
+    void printBinary(std::ostream &) const;
+
+    static void printBinaryHeader(std::ostream &, std::size_t varSize);
+
+    static std::size_t binaryBitmapSize(std::size_t varSize) { return (varSize + 7) / 8; }
 
 protected:
     std::size_t computeFixedCount() const override;
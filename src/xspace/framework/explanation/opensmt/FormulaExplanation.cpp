@@ -13,11 +13,15 @@
 #include <ostream>
 
 namespace xspace::opensmt {
-FormulaExplanation::FormulaExplanation(Framework const & fw, Formula const & phi)
+FormulaExplanation::FormulaExplanation(Framework const & fw, xai::verifiers::OpenSMTVerifier const & verifier,
+                                       Formula const & phi)
     : Explanation{fw},
-      formulaPtr{MAKE_UNIQUE(phi)} {}
+      formulaPtr{MAKE_UNIQUE(phi)},
+      verifierPtr{&verifier} {}
 
 xai::verifiers::OpenSMTVerifier const & FormulaExplanation::getVerifier() const {
+    if (verifierPtr) { return *verifierPtr; }
+
     assert(dynamic_cast<xai::verifiers::OpenSMTVerifier const *>(&getExpand().getVerifier()));
     return static_cast<xai::verifiers::OpenSMTVerifier const &>(getExpand().getVerifier());
 }
@@ -72,6 +76,7 @@ void FormulaExplanation::swap(FormulaExplanation & rhs) {
     Explanation::swap(rhs);
 
     std::swap(formulaPtr, rhs.formulaPtr);
+    std::swap(verifierPtr, rhs.verifierPtr);
 }
 
 void FormulaExplanation::printSmtLib2(std::ostream & os) const {
@@ -19,7 +19,8 @@ using Formula = ::opensmt::PTRef;
 class FormulaExplanation : public Explanation {
 public:
     using Explanation::Explanation;
-    explicit FormulaExplanation(Framework const &, Formula const &);
+    // The formula belongs to the given verifier, which may differ from the one of the framework
+    explicit FormulaExplanation(Framework const &, xai::verifiers::OpenSMTVerifier const &, Formula const &);
 
     Formula const & getFormula() const { return *formulaPtr; }
 
@@ -41,6 +42,8 @@ protected:
     void resetFormula();
 
     std::unique_ptr<Formula> formulaPtr{};
+
+    xai::verifiers::OpenSMTVerifier const * verifierPtr{};
 };
 } // namespace xspace::opensmt
 
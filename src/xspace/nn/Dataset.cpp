@@ -1,41 +1,231 @@
 #include "Dataset.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <numeric>
 #include <ostream>
 #include <ranges>
-#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #ifndef NDEBUG
 #include <cmath>
 #endif
 
 namespace xspace {
-Dataset::Dataset(std::string_view fileName) {
-    std::ifstream file{std::string{fileName}};
-    if (not file.good()) { throw std::ifstream::failure{"Could not open dataset file "s + std::string{fileName}}; }
-
-    // Read the first line to skip the header
-    std::string header;
-    getline(file, header);
-
-    std::string line;
-    Sample::Idx idx{};
-    while (std::getline(file, line)) {
-        std::istringstream ss{line};
-        std::string field;
-        Sample sample;
-        while (std::getline(ss, field, ',')) {
-            sample.push_back(std::stof(field));
+namespace {
+// Read-only view of the whole file that is mapped to memory
+class MappedFile {
+public:
+    MappedFile(std::string const & fileName) {
+        int const fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) { throw std::ifstream::failure{"Could not open dataset file "s + fileName}; }
+        struct ::stat fileStat{};
+        if (::fstat(fd, &fileStat) != 0) {
+            ::close(fd);
+            throw std::ifstream::failure{"Could not open dataset file "s + fileName};
+        }
+        size = fileStat.st_size;
+        if (size == 0) {
+            ::close(fd);
+            return;
+        }
+        void * const addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid after closing the file
+        ::close(fd);
+        if (addr == MAP_FAILED) { throw std::ifstream::failure{"Could not map dataset file "s + fileName}; }
+        ::madvise(addr, size, MADV_SEQUENTIAL);
+        data = static_cast<char const *>(addr);
+    }
+    ~MappedFile() {
+        if (data) { ::munmap(const_cast<char *>(data), size); }
+    }
+    MappedFile(MappedFile const &) = delete;
+    MappedFile & operator=(MappedFile const &) = delete;
+
+    std::string_view view() const { return {data, size}; }
+
+private:
+    char const * data{};
+    std::size_t size{};
+};
+
+// Minimum size of a chunk that is worth to be parsed by a separate thread
+constexpr std::size_t minChunkSize = 1 << 20;
+
+bool isBlankLine(std::string_view line) {
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+struct LinesCount {
+    std::size_t lines{};
+    // Excluding the blank lines
+    std::size_t rows{};
+};
+
+LinesCount countLines(std::string_view chunk) {
+    LinesCount count;
+    while (not chunk.empty()) {
+        std::size_t const pos = chunk.find('\n');
+        std::string_view const line = chunk.substr(0, pos);
+        if (not isBlankLine(line)) { ++count.rows; }
+        if (pos == std::string_view::npos) { break; }
+        ++count.lines;
+        chunk.remove_prefix(pos + 1);
+    }
+    return count;
+}
+
+// Integers of up to this many digits are exactly representable, hence they can be converted directly
+constexpr int maxExactIntDigits = 7;
+static_assert(std::numeric_limits<Float>::digits >= 24);
+
+std::from_chars_result parseValue(char const * first, char const * last, Float & value) {
+    // Fast path for (typically categorical or pixel) integers
+    char const * ptr = first;
+    bool const negative = (ptr != last and *ptr == '-');
+    if (negative) { ++ptr; }
+    std::int32_t intValue = 0;
+    char const * const digitsBegin = ptr;
+    while (ptr != last and ptr - digitsBegin < maxExactIntDigits and *ptr >= '0' and *ptr <= '9') {
+        intValue = intValue * 10 + (*ptr - '0');
+        ++ptr;
+    }
+    bool const isDelimiter = (ptr == last or *ptr == ',' or *ptr == ' ' or *ptr == '\t' or *ptr == '\r');
+    if (ptr != digitsBegin and isDelimiter) {
+        value = negative ? -Float(intValue) : Float(intValue);
+        return {ptr, std::errc{}};
+    }
+
+    return std::from_chars(first, last, value);
+}
+
+// Parses the lines of the chunk into rows of `nFields` values that are stored from `values` on
+// `firstLineNum` is only used in error messages
+void parseLines(std::string_view chunk, std::size_t nFields, Float * values, std::size_t firstLineNum,
+                std::string_view fileName) {
+    std::size_t lineNum = firstLineNum;
+    auto const invalid = [&](std::string_view msg) {
+        return std::invalid_argument{std::string{msg} + " at line " + std::to_string(lineNum) + " of dataset file " +
+                                     std::string{fileName}};
+    };
+
+    while (not chunk.empty()) {
+        std::size_t const pos = chunk.find('\n');
+        std::string_view const line = chunk.substr(0, pos);
+        chunk.remove_prefix((pos == std::string_view::npos) ? chunk.size() : pos + 1);
+        ++lineNum;
+        if (isBlankLine(line)) { continue; }
+
+        char const * ptr = line.data();
+        char const * const end = ptr + line.size();
+        for (std::size_t field = 0; field < nFields; ++field) {
+            while (ptr != end and (*ptr == ' ' or *ptr == '\t')) {
+                ++ptr;
+            }
+            if (ptr != end and *ptr == '+') { ++ptr; }
+            auto const [fieldEnd, ec] = parseValue(ptr, end, *values);
+            if (ec != std::errc{}) { throw invalid("Invalid value"); }
+            ++values;
+            ptr = fieldEnd;
+            while (ptr != end and (*ptr == ' ' or *ptr == '\t' or *ptr == '\r')) {
+                ++ptr;
+            }
+            bool const isLastField = (field + 1 == nFields);
+            if (isLastField) { break; }
+            if (ptr == end or *ptr != ',') { throw invalid("Missing values"); }
+            ++ptr;
         }
-        assert(not sample.empty());
-        Float expectedClassFloat = sample.back();
+        if (ptr != end) { throw invalid("Too many values"); }
+    }
+}
+} // namespace
+
+Dataset::Dataset(std::string_view fileName, std::size_t nThreads) {
+    MappedFile const file{std::string{fileName}};
+    std::string_view contents = file.view();
+
+    // Read the first line to skip the header, it also determines the no. fields
+    std::size_t const headerEnd = contents.find('\n');
+    std::string_view const header = contents.substr(0, headerEnd);
+    std::size_t const nFields = std::ranges::count(header, ',') + 1;
+    // The last field is the expected class
+    if (nFields < 2) { throw std::invalid_argument{"Missing fields in dataset file "s + std::string{fileName}}; }
+    contents.remove_prefix((headerEnd == std::string_view::npos) ? contents.size() : headerEnd + 1);
+
+    // Split the contents into chunks at line boundaries
+    if (nThreads == 0) { nThreads = std::max(1u, std::thread::hardware_concurrency()); }
+    std::size_t const nChunks = std::clamp<std::size_t>(contents.size() / minChunkSize, 1, nThreads);
+    std::vector<std::string_view> chunks;
+    chunks.reserve(nChunks);
+    std::string_view rest = contents;
+    for (std::size_t i = 1; i < nChunks and not rest.empty(); ++i) {
+        std::size_t const pos = rest.find('\n', rest.size() / (nChunks - i + 1));
+        if (pos == std::string_view::npos) { break; }
+        chunks.push_back(rest.substr(0, pos + 1));
+        rest.remove_prefix(pos + 1);
+    }
+    chunks.push_back(rest);
+
+    auto const runInParallel = [&](auto && f) {
+        if (chunks.size() == 1) {
+            f(0);
+            return;
+        }
+        std::vector<std::jthread> threads;
+        threads.reserve(chunks.size());
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            threads.emplace_back(f, i);
+        }
+    };
+
+    // The first pass only counts the rows such that the second pass can parse them right into their place
+    std::vector<std::size_t> chunkRows(chunks.size());
+    std::vector<std::size_t> chunkLines(chunks.size());
+    runInParallel([&](std::size_t i) {
+        auto const count = countLines(chunks[i]);
+        chunkRows[i] = count.rows;
+        chunkLines[i] = count.lines;
+    });
+
+    std::size_t const nRows = std::reduce(chunkRows.begin(), chunkRows.end());
+    std::vector<Float> values(nRows * nFields);
+
+    std::vector<std::exception_ptr> exceptions(chunks.size());
+    runInParallel([&](std::size_t i) {
+        std::size_t const firstRow = std::reduce(chunkRows.begin(), chunkRows.begin() + i);
+        // Accounts for the header
+        std::size_t const firstLineNum = std::reduce(chunkLines.begin(), chunkLines.begin() + i) + 1;
+        try {
+            parseLines(chunks[i], nFields, values.data() + firstRow * nFields, firstLineNum, fileName);
+        } catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+    });
+    for (auto & exceptionPtr : exceptions) {
+        if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+    }
+
+    // Move the expected classes out of the rows in place
+    _sampleSize = nFields - 1;
+    expectedClassifications.reserve(nRows);
+    for (Sample::Idx idx = 0; idx < nRows; ++idx) {
+        Float const * const row = values.data() + idx * nFields;
+        Float expectedClassFloat = row[_sampleSize];
         assert(expectedClassFloat == std::floor(expectedClassFloat));
-        sample.pop_back();
-        samples.push_back(std::move(sample));
+        std::copy(row, row + _sampleSize, values.begin() + idx * _sampleSize);
 
         Classification::Label label = expectedClassFloat;
         expectedClassifications.push_back({.label = label});
@@ -45,12 +235,13 @@ Dataset::Dataset(std::string_view fileName) {
 
         SampleIndices & sampleIndicesOfClass = getSampleIndicesOfClass(label);
         sampleIndicesOfClass.push_back(idx);
-
-        ++idx;
     }
+    values.resize(nRows * _sampleSize);
+    values.shrink_to_fit();
+    samplesData = std::move(values);
 
-    assert(not samples.empty());
-    assert(size() == samples.size());
+    assert(not samplesData.empty());
+    assert(samplesData.size() == size() * sampleSize());
     assert(size() == expectedClassifications.size());
 
     assert(classificationSize() >= 2);
@@ -58,6 +249,36 @@ Dataset::Dataset(std::string_view fileName) {
     assert(classificationSize() == sampleIndicesOfClasses.size());
 }
 
+Dataset::Dataset(std::vector<Float> data, std::size_t sampleSize_, Classifications classifications,
+                 std::size_t classificationSize_)
+    : samplesData{std::move(data)},
+      _sampleSize{sampleSize_},
+      expectedClassifications{std::move(classifications)} {
+    if (samplesData.size() != size() * sampleSize()) {
+        throw std::invalid_argument{"Expected "s + std::to_string(size() * sampleSize()) +
+                                    " values of the samples, got: " + std::to_string(samplesData.size())};
+    }
+
+    // Including the classes without any samples
+    sampleIndicesOfClasses.resize(classificationSize_);
+    std::size_t const size_ = size();
+    for (Sample::Idx idx = 0; idx < size_; ++idx) {
+        Classification::Label const label = expectedClassifications[idx].label;
+        if (label >= classificationSize_) {
+            throw std::invalid_argument{"Expected class out of range: "s + std::to_string(label)};
+        }
+        getSampleIndicesOfClass(label).push_back(idx);
+    }
+#ifndef NDEBUG
+    for (Classification::Label label = 0; label < classificationSize_; ++label) {
+        classificationLabels.insert(label);
+    }
+#endif
+
+    assert(classificationSize() >= 2);
+    assert(classificationSize() == classificationSize_);
+}
+
 std::size_t Dataset::classificationSize() const {
     return sampleIndicesOfClasses.size();
 }
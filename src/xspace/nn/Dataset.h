@@ -6,6 +6,8 @@
 
 #include <cassert>
 #include <iosfwd>
+#include <ranges>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -16,15 +18,15 @@
 namespace xspace {
 class Dataset {
 public:
-    struct Sample : std::vector<Float> {
+    // View of a row of the samples, which are stored contiguously
+    struct Sample : std::span<Float const> {
         using Idx = size_type;
 
-        using vector::vector;
+        using span::span;
 
         void print(std::ostream &) const;
     };
 
-    using Samples = std::vector<Sample>;
     using SampleIndices = std::vector<Sample::Idx>;
 
     struct Classification {
@@ -44,16 +46,29 @@ public:
 
     using Outputs = std::vector<Output>;
 
-    Dataset(std::string_view fileName);
+    // The file is parsed in parallel chunks by `nThreads` threads, 0 means the no. hardware threads
+    Dataset(std::string_view fileName, std::size_t nThreads = 0);
+    // The samples are given directly as a row-major array, e.g. received by the server
+    // The no. classes cannot be inferred from the expected classes of only a few samples
+    Dataset(std::vector<Float> samplesData, std::size_t sampleSize, Classifications, std::size_t classificationSize);
 
-    std::size_t size() const { return getSamples().size(); }
+    std::size_t size() const { return expectedClassifications.size(); }
 
     std::size_t classificationSize() const;
 
-    Samples const & getSamples() const { return samples; }
-    Sample const & getSample(Sample::Idx idx) const {
+    // The no. values of each sample
+    std::size_t sampleSize() const { return _sampleSize; }
+
+    // All samples in a row-major array
+    std::span<Float const> getSamplesData() const { return samplesData; }
+
+    auto getSamples() const {
+        return std::views::iota(Sample::Idx{0}, size()) |
+               std::views::transform([this](Sample::Idx idx) { return getSample(idx); });
+    }
+    Sample getSample(Sample::Idx idx) const {
         assert(idx < size());
-        return samples[idx];
+        return {samplesData.data() + idx * sampleSize(), sampleSize()};
     }
 
     SampleIndices getSampleIndices() const;
@@ -87,7 +102,8 @@ protected:
     void setCorrectAndIncorrectSamples();
 
     // The original order of the samples should remain unchanged
-    Samples samples{};
+    std::vector<Float> samplesData{};
+    std::size_t _sampleSize{};
 
     Classifications expectedClassifications{};
 
@@ -0,0 +1,451 @@
+#include "Server.h"
+
+#include <xspace/framework/explanation/Explanation.h>
+#include <xspace/nn/Dataset.h>
+
+#include <xspace/common/String.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace xspace {
+namespace {
+// Only as much of JSON as the requests need
+struct JsonValue {
+    using Array = std::vector<JsonValue>;
+    // Keeps the order of the members, the objects of the requests are small
+    using Object = std::vector<std::pair<std::string, JsonValue>>;
+
+    JsonValue const * find(std::string_view key) const {
+        auto const * objectPtr = std::get_if<Object>(&value);
+        if (not objectPtr) { return nullptr; }
+        auto const it = std::ranges::find(*objectPtr, key, &Object::value_type::first);
+        return (it == objectPtr->end()) ? nullptr : &it->second;
+    }
+
+    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> value{};
+};
+
+class JsonParser {
+public:
+    JsonParser(std::string_view str_) : str{str_} {}
+
+    JsonValue parse() {
+        JsonValue val = parseValue();
+        skipWhitespace();
+        if (pos != str.size()) { throwError("trailing characters"); }
+        return val;
+    }
+
+protected:
+    [[noreturn]]
+    void throwError(std::string const & msg) const {
+        throw std::invalid_argument{"Invalid JSON at position "s + std::to_string(pos) + ": " + msg};
+    }
+
+    void skipWhitespace() {
+        while (pos < str.size() and std::string_view{whitespace}.find(str[pos]) != std::string_view::npos) {
+            ++pos;
+        }
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (pos == str.size() or str[pos] != c) { return false; }
+        ++pos;
+        return true;
+    }
+
+    void expect(char c) {
+        if (not consume(c)) { throwError("expected '"s + c + "'"); }
+    }
+
+    bool consumeLiteral(std::string_view literal) {
+        if (not str.substr(pos).starts_with(literal)) { return false; }
+        pos += literal.size();
+        return true;
+    }
+
+    JsonValue parseValue() {
+        skipWhitespace();
+        if (pos == str.size()) { throwError("unexpected end"); }
+
+        char const c = str[pos];
+        if (c == '{') { return {parseObject()}; }
+        if (c == '[') { return {parseArray()}; }
+        if (c == '"') { return {parseString()}; }
+        if (consumeLiteral("true")) { return {true}; }
+        if (consumeLiteral("false")) { return {false}; }
+        if (consumeLiteral("null")) { return {nullptr}; }
+        return {parseNumber()};
+    }
+
+    JsonValue::Object parseObject() {
+        expect('{');
+        JsonValue::Object object;
+        if (consume('}')) { return object; }
+        do {
+            skipWhitespace();
+            std::string key = parseString();
+            expect(':');
+            object.emplace_back(std::move(key), parseValue());
+        } while (consume(','));
+        expect('}');
+        return object;
+    }
+
+    JsonValue::Array parseArray() {
+        expect('[');
+        JsonValue::Array array;
+        if (consume(']')) { return array; }
+        do {
+            array.push_back(parseValue());
+        } while (consume(','));
+        expect(']');
+        return array;
+    }
+
+    std::string parseString() {
+        if (pos == str.size() or str[pos] != '"') { throwError("expected a string"); }
+        ++pos;
+        std::string result;
+        while (pos < str.size() and str[pos] != '"') {
+            char c = str[pos++];
+            if (c == '\\') {
+                if (pos == str.size()) { break; }
+                c = str[pos++];
+                switch (c) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case '"':
+                    case '\\':
+                    case '/': break;
+                    // The specs and the other strings of the requests are ASCII
+                    default: throwError("unsupported escape sequence");
+                }
+            }
+            result += c;
+        }
+        if (pos == str.size()) { throwError("unterminated string"); }
+        ++pos;
+        return result;
+    }
+
+    double parseNumber() {
+        double val;
+        auto const [ptr, ec] = std::from_chars(str.data() + pos, str.data() + str.size(), val);
+        if (ec != std::errc{}) { throwError("expected a value"); }
+        pos = ptr - str.data();
+        return val;
+    }
+
+    std::string_view str;
+    std::size_t pos{};
+};
+
+void printJsonString(std::ostream & os, std::string_view str) {
+    os << '"';
+    for (char c : str) {
+        switch (c) {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\t': os << "\\t"; break;
+            case '\r': os << "\\r"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    os << buf;
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+std::vector<Float> toSample(JsonValue const & val) {
+    auto const * arrayPtr = std::get_if<JsonValue::Array>(&val.value);
+    if (not arrayPtr) { throw std::invalid_argument{"A sample must be an array of values"}; }
+    std::vector<Float> sample;
+    sample.reserve(arrayPtr->size());
+    for (auto const & elem : *arrayPtr) {
+        auto const * numPtr = std::get_if<double>(&elem.value);
+        if (not numPtr) { throw std::invalid_argument{"A sample must be an array of values"}; }
+        sample.push_back(*numPtr);
+    }
+    return sample;
+}
+
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd_) : fd{fd_} {}
+    ~FileDescriptor() {
+        if (fd >= 0) { ::close(fd); }
+    }
+    FileDescriptor(FileDescriptor const &) = delete;
+    FileDescriptor & operator=(FileDescriptor const &) = delete;
+
+    int get() const { return fd; }
+
+private:
+    int fd;
+};
+
+[[noreturn]]
+void throwSystemError(std::string const & msg) {
+    throw std::system_error{errno, std::generic_category(), msg};
+}
+} // namespace
+
+Server::Server(Framework::Config const & conf, std::unique_ptr<xai::nn::NNet> nn, std::string vfName,
+               std::string defaultSpec)
+    : config{conf},
+      networkPtr{std::move(nn)},
+      verifierName{std::move(vfName)},
+      defaultStrategiesSpec{std::move(defaultSpec)} {
+    assert(networkPtr);
+    if (config.printingIntervalExplanationsInBinaryFormat()) {
+        throw std::invalid_argument{"The server does not support the binary format of the explanations"};
+    }
+    // The explanations are returned in the responses instead
+    config.discardOutput();
+    // The responses are built after the expansion, when the verifier would have been reset otherwise,
+    // while e.g. the formula explanations refer to the terms of the verifier
+    // Keeping the model resident is the point of the server anyway
+    config.usePersistentModel();
+
+    // Reports an invalid spec right away and prepares the framework of the most common requests
+    getFramework(defaultStrategiesSpec);
+}
+
+Server::~Server() = default;
+
+Framework & Server::getFramework(std::string const & strategiesSpec) {
+    ++useCounter;
+    if (auto const it = frameworks.find(strategiesSpec); it != frameworks.end()) {
+        auto & entry = it->second;
+        entry.lastUse = useCounter;
+        return *entry.frameworkPtr;
+    }
+
+    // An invalid spec throws before anything is dropped
+    std::istringstream strategiesSpecIss{strategiesSpec};
+    auto frameworkPtr = std::make_unique<Framework>(config, std::make_unique<xai::nn::NNet>(*networkPtr),
+                                                    verifierName, strategiesSpecIss);
+
+    if (frameworks.size() >= maxFrameworks) {
+        auto lruIt = frameworks.end();
+        for (auto it = frameworks.begin(); it != frameworks.end(); ++it) {
+            if (it->first == defaultStrategiesSpec) { continue; }
+            if (lruIt == frameworks.end() or it->second.lastUse < lruIt->second.lastUse) { lruIt = it; }
+        }
+        assert(lruIt != frameworks.end());
+        frameworks.erase(lruIt);
+    }
+
+    auto & framework = *frameworkPtr;
+    frameworks.emplace(strategiesSpec, FrameworkEntry{.frameworkPtr = std::move(frameworkPtr), .lastUse = useCounter});
+    return framework;
+}
+
+std::string Server::handleRequest(std::string_view request) try {
+    using Clock = std::chrono::steady_clock;
+    auto const requestStart = Clock::now();
+
+    JsonValue const requestJson = JsonParser{request}.parse();
+    if (not std::holds_alternative<JsonValue::Object>(requestJson.value)) {
+        throw std::invalid_argument{"A request must be an object"};
+    }
+
+    if (auto const * shutdownPtr = requestJson.find("shutdown")) {
+        if (auto const * valPtr = std::get_if<bool>(&shutdownPtr->value); valPtr and *valPtr) {
+            shutdown = true;
+            return R"({"shutdown": true})";
+        }
+    }
+
+    std::vector<std::vector<Float>> samples;
+    if (auto const * samplePtr = requestJson.find("sample")) {
+        samples.push_back(toSample(*samplePtr));
+    } else if (auto const * samplesPtr = requestJson.find("samples")) {
+        auto const * arrayPtr = std::get_if<JsonValue::Array>(&samplesPtr->value);
+        if (not arrayPtr) { throw std::invalid_argument{"The samples must be an array"}; }
+        for (auto const & sampleJson : *arrayPtr) {
+            samples.push_back(toSample(sampleJson));
+        }
+    } else {
+        throw std::invalid_argument{"Missing the samples"};
+    }
+
+    std::vector<std::size_t> labels;
+    if (auto const * labelsPtr = requestJson.find("labels")) {
+        auto const * arrayPtr = std::get_if<JsonValue::Array>(&labelsPtr->value);
+        if (not arrayPtr or arrayPtr->size() != samples.size()) {
+            throw std::invalid_argument{"The labels must be an array with a class of each sample"};
+        }
+        for (auto const & labelJson : *arrayPtr) {
+            auto const * numPtr = std::get_if<double>(&labelJson.value);
+            if (not numPtr or *numPtr < 0 or *numPtr != std::floor(*numPtr)) {
+                throw std::invalid_argument{"A class must be a non-negative integer"};
+            }
+            labels.push_back(*numPtr);
+        }
+    }
+
+    std::string strategiesSpec = defaultStrategiesSpec;
+    if (auto const * strategiesPtr = requestJson.find("strategies")) {
+        auto const * strPtr = std::get_if<std::string>(&strategiesPtr->value);
+        if (not strPtr) { throw std::invalid_argument{"The strategies must be a string"}; }
+        strategiesSpec = *strPtr;
+    }
+
+    Framework & framework = getFramework(strategiesSpec);
+    std::size_t const varSize = framework.varSize();
+    std::size_t const classificationSize = framework.classificationSize();
+
+    std::ostringstream responseOss;
+    responseOss << R"({"explanations": [)";
+    std::size_t const nSamples = samples.size();
+    for (std::size_t i = 0; i < nSamples; ++i) {
+        auto & sample = samples[i];
+        if (sample.size() != varSize) {
+            throw std::invalid_argument{"Expected "s + std::to_string(varSize) + " values of a sample, got: " +
+                                        std::to_string(sample.size())};
+        }
+
+        auto const sampleStart = Clock::now();
+        Dataset::Classification const expectedClassification{
+            .label = labels.empty() ? framework.computeClassificationLabel(sample) : labels[i]};
+        Dataset dataset{std::move(sample), varSize, {expectedClassification}, classificationSize};
+        Explanations explanations = framework.explain(dataset);
+        assert(explanations.size() == 1);
+        std::chrono::duration<double> const sampleTime = Clock::now() - sampleStart;
+
+        auto const & explanation = *explanations.front();
+        std::ostringstream explanationOss;
+        explanation.print(explanationOss);
+
+        if (i > 0) { responseOss << ", "; }
+        responseOss << R"({"explanation": )";
+        printJsonString(responseOss, std::move(explanationOss).view());
+        responseOss << R"(, "features": )" << explanation.varSize();
+        if (explanation.supportsVolume()) {
+            responseOss << R"(, "relVolume": )" << explanation.getRelativeVolumeSkipFixed();
+        }
+        responseOss << R"(, "time": )" << sampleTime.count() << '}';
+    }
+
+    std::chrono::duration<double> const requestTime = Clock::now() - requestStart;
+    responseOss << R"(], "time": )" << requestTime.count() << '}';
+
+    return std::move(responseOss).str();
+} catch (std::exception const & e) {
+    std::ostringstream responseOss;
+    responseOss << R"({"error": )";
+    printJsonString(responseOss, e.what());
+    responseOss << '}';
+    return std::move(responseOss).str();
+}
+
+void Server::serve(std::string const & socketPath) {
+    ::sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument{"The socket path is too long: "s + socketPath};
+    }
+    std::ranges::copy(socketPath, addr.sun_path);
+
+    FileDescriptor const listenFd{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (listenFd.get() < 0) { throwSystemError("Could not create the socket"); }
+
+    // The file of a socket is not removed when the previous server terminates abruptly,
+    // but any other file at the path is kept
+    if (struct ::stat st; ::lstat(socketPath.c_str(), &st) == 0) {
+        if (not S_ISSOCK(st.st_mode)) {
+            throw std::invalid_argument{"The socket path exists and is not a socket: "s + socketPath};
+        }
+        ::unlink(socketPath.c_str());
+    } else if (errno != ENOENT) {
+        throwSystemError("Could not access the socket path "s + socketPath);
+    }
+    if (::bind(listenFd.get(), reinterpret_cast<::sockaddr const *>(&addr), sizeof(addr)) != 0) {
+        throwSystemError("Could not bind the socket "s + socketPath);
+    }
+    if (::listen(listenFd.get(), SOMAXCONN) != 0) { throwSystemError("Could not listen on the socket "s + socketPath); }
+
+    while (not shutdown) {
+        FileDescriptor const connFd{::accept(listenFd.get(), nullptr, nullptr)};
+        if (connFd.get() < 0) {
+            if (errno == EINTR) { continue; }
+            throwSystemError("Could not accept a connection");
+        }
+        serveConnection(connFd.get());
+    }
+
+    ::unlink(socketPath.c_str());
+}
+
+void Server::serveConnection(int fd) {
+    constexpr std::size_t bufferSize = 1 << 16;
+
+    auto const sendAll = [fd](std::string_view data) {
+        while (not data.empty()) {
+            // The client may have closed the connection, which must not terminate the server by SIGPIPE
+            ::ssize_t const n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) { continue; }
+                return false;
+            }
+            data.remove_prefix(n);
+        }
+        return true;
+    };
+
+    std::string pending;
+    std::vector<char> buffer(bufferSize);
+    while (not shutdown) {
+        ::ssize_t const n = ::read(fd, buffer.data(), buffer.size());
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            return;
+        }
+        if (n == 0) { return; }
+        pending.append(buffer.data(), n);
+
+        std::size_t lineStart = 0;
+        for (std::size_t lineEnd; (lineEnd = pending.find('\n', lineStart)) != std::string::npos;) {
+            std::string_view const line = trim(std::string_view{pending}.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+            if (line.empty()) { continue; }
+
+            std::string response = handleRequest(line);
+            response += '\n';
+            if (not sendAll(response)) { return; }
+            if (shutdown) { return; }
+        }
+        pending.erase(0, lineStart);
+    }
+}
+} // namespace xspace
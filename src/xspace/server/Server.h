@@ -0,0 +1,72 @@
+#ifndef XSPACE_SERVER_H
+#define XSPACE_SERVER_H
+
+#include <xspace/framework/Config.h>
+#include <xspace/framework/Framework.h>
+
+#include <nn/NNet.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace xspace {
+// Long-running server that keeps the model, the frameworks and their verifiers resident,
+// and explains the samples of the requests received over a local (Unix domain) socket
+// Each request and each response is a single line of JSON:
+//   {"samples": [[<value>, ...], ...], "strategies": "<spec>", "labels": [<class>, ...]}
+//   {"explanations": [{"explanation": "...", "features": <n>, "relVolume": <x>, "time": <s>}, ...], "time": <s>}
+// "sample": [...] stands for a single sample, the strategies default to those the server was started with,
+// and the expected classes default to the computed ones
+// A failed request results in {"error": "..."}, and {"shutdown": true} stops the server after the response
+// The connections are served one at a time, and the model is always persistent (as with -p)
+class Server {
+public:
+    Server(Framework::Config const &, std::unique_ptr<xai::nn::NNet>, std::string verifierName,
+           std::string defaultStrategiesSpec);
+    ~Server();
+
+    // Blocks until a shutdown request is received
+    // A stale socket at the path is replaced, but any other existing file is an error
+    void serve(std::string const & socketPath);
+
+    // Returns the response to the request without the line delimiter
+    std::string handleRequest(std::string_view request);
+
+    bool shutdownRequested() const { return shutdown; }
+
+protected:
+    // Reads the requests of the connection until it is closed or until a shutdown request
+    void serveConnection(int fd);
+
+    // The frameworks are kept per strategies spec, so that the verifiers stay warm across the requests
+    // At most maxFrameworks are kept, the least recently used one is dropped first,
+    // except the one of the default strategies
+    Framework & getFramework(std::string const & strategiesSpec);
+
+    static constexpr std::size_t maxFrameworks = 8;
+
+    Framework::Config config;
+
+    // Each framework has its own copy, which shares the parameters of the model
+    std::unique_ptr<xai::nn::NNet> networkPtr;
+
+    std::string verifierName;
+    std::string defaultStrategiesSpec;
+
+    struct FrameworkEntry {
+        std::unique_ptr<Framework> frameworkPtr;
+        // The value of useCounter at the last request that used the framework
+        std::size_t lastUse{};
+    };
+
+    std::map<std::string, FrameworkEntry> frameworks{};
+    std::size_t useCounter{};
+
+    bool shutdown{};
+};
+} // namespace xspace
+
+#endif // XSPACE_SERVER_H